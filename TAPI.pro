@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT += core gui network sql
+QT += concurrent core gui network sql
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -12,45 +12,96 @@ TARGET = TAPI
 TEMPLATE = app
 
 HEADERS += buildrequestwindow.h \
+           communicationmodel.h \
            connection.h \
            credentials.h \
            database.h \
+           datatable.h \
+           datatablemodel.h \
+           datatablewindow.h \
+           diffwindow.h \
            endpoint.h \
            endpointswindow.h \
            error.h \
+           harreader.h \
+           harwriter.h \
+           journal.h \
+           journalmodel.h \
+           jsondiff.h \
+           jsonquery.h \
+           jsonscanner.h \
+           jsonviewer.h \
            logwindow.h \
            mainwindow.h \
            methods.h \
            pathwindow.h \
            random.h \
+           replayengine.h \
+           replaywindow.h \
+           replybuffer.h \
            request.h \
            requestwindow.h \
            responsewindow.h \
            session.h \
+           storedbody.h \
+           swaggercache.h \
+           swaggerloader.h \
+           swaggermodel.h \
+           swaggerreader.h \
            tables.h \
            tablewidget.h \
+           timingstatistics.h \
            tokenwindow.h \
+           trigramindex.h \
            types.h \
+           uuidscanner.h \
            ui/ui_buildrequestwindow.h \
+           ui/ui_datatablewindow.h \
+           ui/ui_diffwindow.h \
            ui/ui_endpointswindow.h \
            ui/ui_logwindow.h \
            ui/ui_mainwindow.h \
            ui/ui_pathwindow.h \
+           ui/ui_replaywindow.h \
            ui/ui_requestwindow.h \
            ui/ui_responsewindow.h \
            ui/ui_tokenwindow.h
 
 SOURCES += buildrequestwindow.cpp \
+           communicationmodel.cpp \
            database.cpp \
+           datatable.cpp \
+           datatablemodel.cpp \
+           datatablewindow.cpp \
+           diffwindow.cpp \
            endpoint.cpp \
            endpointswindow.cpp \
+           harreader.cpp \
+           harwriter.cpp \
+           journal.cpp \
+           journalmodel.cpp \
+           jsondiff.cpp \
+           jsonquery.cpp \
+           jsonscanner.cpp \
+           jsonviewer.cpp \
            logwindow.cpp \
            main.cpp \
            mainwindow.cpp \
            random.cpp \
+           replayengine.cpp \
+           replaywindow.cpp \
+           replybuffer.cpp \
            request.cpp \
            responsewindow.cpp \
-           session.cpp
+           session.cpp \
+           storedbody.cpp \
+           swaggercache.cpp \
+           swaggerloader.cpp \
+           swaggermodel.cpp \
+           swaggerreader.cpp \
+           timingstatistics.cpp \
+           trigramindex.cpp \
+           uuidscanner.cpp
 
 DISTFILES += notes.txt
 
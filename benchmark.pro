@@ -0,0 +1,67 @@
+#-------------------------------------------------
+#
+# Benchmarks of parsing hot paths (QtTest)
+# run: TAPI_benchmark [-iterations n] [-csv]
+#
+#-------------------------------------------------
+
+QT += concurrent core gui network sql testlib widgets
+
+TARGET = TAPI_benchmark
+TEMPLATE = app
+
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD
+
+HEADERS += benchmark/responsebenchmark.h \
+           connection.h \
+           credentials.h \
+           database.h \
+           datatable.h \
+           datatablemodel.h \
+           endpoint.h \
+           error.h \
+           harreader.h \
+           harwriter.h \
+           journal.h \
+           jsondiff.h \
+           jsonquery.h \
+           jsonscanner.h \
+           methods.h \
+           replybuffer.h \
+           request.h \
+           session.h \
+           storedbody.h \
+           swaggercache.h \
+           swaggerloader.h \
+           swaggermodel.h \
+           swaggerreader.h \
+           tables.h \
+           trigramindex.h \
+           types.h \
+           uuidscanner.h
+
+SOURCES += benchmark/parsingbenchmark.cpp \
+           benchmark/responsebenchmark.cpp \
+           database.cpp \
+           datatable.cpp \
+           datatablemodel.cpp \
+           endpoint.cpp \
+           harreader.cpp \
+           harwriter.cpp \
+           journal.cpp \
+           jsondiff.cpp \
+           jsonquery.cpp \
+           jsonscanner.cpp \
+           replybuffer.cpp \
+           request.cpp \
+           session.cpp \
+           storedbody.cpp \
+           swaggercache.cpp \
+           swaggerloader.cpp \
+           swaggermodel.cpp \
+           swaggerreader.cpp \
+           trigramindex.cpp \
+           uuidscanner.cpp
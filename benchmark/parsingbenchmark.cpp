@@ -0,0 +1,289 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <QUuid>
+#include "request.h"
+#include "responsebenchmark.h"
+#include "session.h"
+#include "swaggerreader.h"
+
+// benchmarks of parsing hot paths on shipped fixtures (swagger1.json, swagger2.json,
+// json/endpoints.json) and on their larger generated variants; cases working with
+// body of GET response are in ResponseBenchmark
+class ParsingBenchmark: public QObject {
+
+    Q_OBJECT
+
+    private:
+        static QByteArray readFixture(const QString &);
+        static QByteArray multiplySwagger(const QByteArray &, const int);
+        static QByteArray multiplyEndpoints(const QByteArray &, const int);
+        static quint64 addReply(Session &, const QByteArray &);
+
+        QString writeVariant(const QString &, const QByteArray &);
+
+        QTemporaryDir _variantsDir;
+        QByteArray _swagger1;
+        QByteArray _swagger2;
+        QByteArray _endpoints;
+
+    private slots:
+        void initTestCase();
+
+        void parseSwaggerFile_data();
+        void parseSwaggerFile();
+        void readSwagger_data();
+        void readSwagger();
+
+        void parseEndpointsReply_data();
+        void parseEndpointsReply();
+
+        void dataFromBulkReply();
+};
+
+QByteArray ParsingBenchmark::readFixture(const QString & fileName) {
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+
+    return file.readAll();
+}
+
+QByteArray ParsingBenchmark::multiplySwagger(const QByteArray & contents, const int factor) {
+
+    QJsonObject swagger = QJsonDocument::fromJson(contents).object();
+    const QJsonObject paths = swagger["paths"].toObject();
+    const QJsonObject definitions = swagger["definitions"].toObject();
+
+    QJsonObject newPaths(paths);
+    QJsonObject newDefinitions(definitions);
+
+    for (int i = 1; i < factor; ++i) {
+
+        const QString copy = QString::number(i);
+
+        for (QJsonObject::const_iterator it = paths.constBegin(); it != paths.constEnd(); ++it)
+            newPaths.insert(QStringLiteral("/copy") + copy + it.key(), it.value());
+        for (QJsonObject::const_iterator it = definitions.constBegin(); it != definitions.constEnd(); ++it)
+            newDefinitions.insert(it.key() + QStringLiteral("_") + copy, it.value());
+    }
+
+    swagger["paths"] = newPaths;
+    swagger["definitions"] = newDefinitions;
+
+    return QJsonDocument(swagger).toJson(QJsonDocument::Compact);
+}
+
+QByteArray ParsingBenchmark::multiplyEndpoints(const QByteArray & contents, const int factor) {
+
+    QJsonObject endpoints = QJsonDocument::fromJson(contents).object();
+    QJsonArray data = endpoints["Data"].toArray();
+
+    // every version, module and entity gets (factor-1) copies of its methods
+    for (int d = 0; d < data.size(); ++d) {
+
+        QJsonObject version = data[d].toObject();
+        QJsonArray modules = version["Modules"].toArray();
+
+        for (int m = 0; m < modules.size(); ++m) {
+
+            QJsonObject module = modules[m].toObject();
+            QJsonArray entities = module["Entities"].toArray();
+
+            for (int e = 0; e < entities.size(); ++e) {
+
+                QJsonObject entity = entities[e].toObject();
+                const QJsonArray methods = entity["Methods"].toArray();
+                QJsonArray newMethods(methods);
+
+                for (int i = 1; i < factor; ++i)
+                    for (auto it: methods) {
+
+                        QJsonObject method = it.toObject();
+                        method["Name"] = QStringLiteral("copy") + QString::number(i) +
+                                         QStringLiteral("/") + method["Name"].toString();
+                        newMethods.append(method);
+                    }
+
+                entity["Methods"] = newMethods;
+                entities[e] = entity;
+            }
+            module["Entities"] = entities;
+            modules[m] = module;
+        }
+        version["Modules"] = modules;
+        data[d] = version;
+    }
+    endpoints["Data"] = data;
+
+    return QJsonDocument(endpoints).toJson(QJsonDocument::Compact);
+}
+
+quint64 ParsingBenchmark::addReply(Session & session, const QByteArray & contents) {
+
+    // the same path as a reply received from server (see Session::setReplyToCurrentRequest)
+    const quint64 ID = Communication::_currentID;
+
+    QNetworkRequest networkRequest;
+    networkRequest.setAttribute(Request::userAttribute(1), ID);
+    session.newMessage(Request(networkRequest, http::GET, QByteArray()));
+
+    const Response reply(contents, QList<QNetworkReply::RawHeaderPair>(), ID);
+    session.communication().last().setReply(reply);
+
+    return ID;
+}
+
+QString ParsingBenchmark::writeVariant(const QString & fileName, const QByteArray & contents) {
+
+    const QString filePath = _variantsDir.filePath(fileName);
+
+    QFile file(filePath);
+    if (file.open(QIODevice::WriteOnly))
+        file.write(contents);
+
+    return filePath;
+}
+
+void ParsingBenchmark::initTestCase() {
+
+    // compiled Swagger snapshots must not end up in user's cache
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(_variantsDir.isValid());
+
+    _swagger1 = readFixture(QFINDTESTDATA("../swagger1.json"));
+    _swagger2 = readFixture(QFINDTESTDATA("../swagger2.json"));
+    _endpoints = readFixture(QFINDTESTDATA("../json/endpoints.json"));
+
+    QVERIFY(!_swagger1.isEmpty());
+    QVERIFY(!_swagger2.isEmpty());
+    QVERIFY(!_endpoints.isEmpty());
+
+    return;
+}
+
+void ParsingBenchmark::parseSwaggerFile_data() {
+
+    QTest::addColumn<QString>("fileName");
+
+    QTest::newRow("swagger1") << QFINDTESTDATA("../swagger1.json");
+    QTest::newRow("swagger2") << QFINDTESTDATA("../swagger2.json");
+    QTest::newRow("swagger2 x10") << writeVariant(QStringLiteral("swagger2x10.json"),
+                                                  multiplySwagger(_swagger2, 10));
+    return;
+}
+
+// file as user opens it (second and further runs are served from compiled snapshot)
+void ParsingBenchmark::parseSwaggerFile() {
+
+    QFETCH(QString, fileName);
+
+    Session session;
+    QBENCHMARK {
+
+        QCOMPARE(session.openFile(fileName), err::NO_ERROR);
+        QVERIFY(session.parseSwaggerFile());
+    }
+    return;
+}
+
+void ParsingBenchmark::readSwagger_data() {
+
+    QTest::addColumn<QByteArray>("contents");
+
+    QTest::newRow("swagger1") << _swagger1;
+    QTest::newRow("swagger2") << _swagger2;
+    QTest::newRow("swagger2 x10") << multiplySwagger(_swagger2, 10);
+
+    return;
+}
+
+// streaming parse only (no snapshot)
+void ParsingBenchmark::readSwagger() {
+
+    QFETCH(QByteArray, contents);
+
+    SwaggerModel model;
+    QBENCHMARK {
+
+        SwaggerReader reader(contents);
+        QVERIFY(reader.read(model));
+    }
+    return;
+}
+
+void ParsingBenchmark::parseEndpointsReply_data() {
+
+    QTest::addColumn<QByteArray>("contents");
+
+    QTest::newRow("endpoints") << _endpoints;
+    QTest::newRow("endpoints x20") << multiplyEndpoints(_endpoints, 20);
+
+    return;
+}
+
+void ParsingBenchmark::parseEndpointsReply() {
+
+    QFETCH(QByteArray, contents);
+
+    Session session;
+    const quint64 ID = addReply(session, contents);
+
+    QBENCHMARK {
+
+        // unchanged list would be skipped
+        session.endpoints()->clear();
+        QVERIFY(session.parseEndpointsReply(ID));
+    }
+    return;
+}
+
+// reply to bulk POST (IDs of inserted records)
+void ParsingBenchmark::dataFromBulkReply() {
+
+    QJsonArray recordIDs;
+    for (int i = 0; i < 10000; ++i)
+        recordIDs.append(QUuid::createUuid().toString(QUuid::WithoutBraces));
+
+    QJsonObject contents;
+    contents["RowCount"] = recordIDs.size();
+    contents["Data"] = recordIDs;
+    const Response reply(QJsonDocument(contents).toJson(QJsonDocument::Indented),
+                         QList<QNetworkReply::RawHeaderPair>(), QVariant(0));
+
+    QVector<QUuid> replyRecordIDs;
+    QVERIFY(!reply.dataFromBody(replyRecordIDs).isEmpty());
+    QCOMPARE(replyRecordIDs.size(), recordIDs.size());
+
+    QBENCHMARK {
+
+        replyRecordIDs.clear();
+        reply.dataFromBody(replyRecordIDs);
+    }
+    return;
+}
+
+// both classes are run (exit code = number of failed cases)
+int main(int argc, char * argv[]) {
+
+    QApplication application(argc, argv);
+    QTEST_SET_MAIN_SOURCE_PATH
+
+    ParsingBenchmark parsingBenchmark;
+    ResponseBenchmark responseBenchmark;
+
+    return (QTest::qExec(&parsingBenchmark, argc, argv) + QTest::qExec(&responseBenchmark, argc, argv));
+}
+
+#include "parsingbenchmark.moc"
@@ -0,0 +1,253 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QtTest>
+#include "datatablemodel.h"
+#include "harreader.h"
+#include "harwriter.h"
+#include "journal.h"
+#include "jsondiff.h"
+#include "jsonquery.h"
+#include "request.h"
+#include "responsebenchmark.h"
+
+QByteArray ResponseBenchmark::multiplyData(const QByteArray & contents, const int factor) {
+
+    QJsonObject response = QJsonDocument::fromJson(contents).object();
+    const QJsonArray data = response["Data"].toArray();
+    QJsonArray newData;
+
+    for (int i = 0; i < factor; ++i)
+        for (auto it: data)
+            newData.append(it);
+
+    response["Data"] = newData;
+    response["RowCount"] = newData.size();
+
+    return QJsonDocument(response).toJson(QJsonDocument::Indented);
+}
+
+// global data => every case is run with both bodies
+void ResponseBenchmark::initTestCase_data() {
+
+    QFile file(QFINDTESTDATA("../json/getall.json"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray getAll = file.readAll();
+    QVERIFY(!getAll.isEmpty());
+
+    QTest::addColumn<QByteArray>("contents");
+
+    QTest::newRow("getall") << getAll;
+    QTest::newRow("getall x100") << multiplyData(getAll, 100);
+
+    return;
+}
+
+void ResponseBenchmark::initTestCase() {
+
+    // journals and HAR files must not end up in user's data
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(_variantsDir.isValid());
+
+    return;
+}
+
+// state attributes as read for every reply (see Session::parseReplyToGeneralRequest)
+void ResponseBenchmark::parseBody() {
+
+    QFETCH(QByteArray, contents);
+
+    QBENCHMARK {
+
+        // every reply is a new response (body is parsed once per response)
+        const Response reply(contents, QList<QNetworkReply::RawHeaderPair>(), QVariant(0));
+
+        StateAttributes attributes;
+        attributes.pageCount = reply.parseBody(QStringLiteral("PageCount"));
+        attributes.rowCount = reply.parseBody(QStringLiteral("RowCount"));
+        attributes.status = reply.parseBody(QStringLiteral("Status"));
+        attributes.message = reply.parseBody(QStringLiteral("Message"));
+        attributes.stackTrace = reply.parseBody(QStringLiteral("StackTrace"));
+        QVERIFY(!attributes.rowCount.isEmpty());
+    }
+    return;
+}
+
+void ResponseBenchmark::dataFromBody() {
+
+    QFETCH(QByteArray, contents);
+
+    QBENCHMARK {
+
+        const Response reply(contents, QList<QNetworkReply::RawHeaderPair>(), QVariant(0));
+
+        QVector<QUuid> recordIDs;
+        QVERIFY(!reply.dataFromBody(recordIDs).isEmpty());
+    }
+    return;
+}
+
+// columnar table of Data section (see DataTableWindow)
+void ResponseBenchmark::readDataTable() {
+
+    QFETCH(QByteArray, contents);
+
+    const Response reply(contents, QList<QNetworkReply::RawHeaderPair>(), QVariant(0));
+    qint64 begin = 0;
+    qint64 end = 0;
+    QVector<QUuid> recordIDs;
+    QVERIFY(reply.locateData(begin, end, recordIDs));
+
+    QBENCHMARK {
+
+        DataTable table;
+        QVERIFY(table.read(contents.constData() + begin, end - begin));
+    }
+    return;
+}
+
+// sorting by string (dictionary-encoded) column and filtering
+void ResponseBenchmark::sortDataTable() {
+
+    QFETCH(QByteArray, contents);
+
+    const Response reply(contents, QList<QNetworkReply::RawHeaderPair>(), QVariant(0));
+    qint64 begin = 0;
+    qint64 end = 0;
+    QVector<QUuid> recordIDs;
+    QVERIFY(reply.locateData(begin, end, recordIDs));
+
+    DataTable table;
+    QVERIFY(table.read(contents.constData() + begin, end - begin));
+    DataTableModel model(table);
+
+    QBENCHMARK {
+
+        model.sort(2, Qt::DescendingOrder);
+        model.setFilter(-1, QStringLiteral("ab"));
+        model.setFilter(-1, QString());
+    }
+    return;
+}
+
+// one compiled query evaluated against history of (already parsed) responses (see LogWindow)
+void ResponseBenchmark::queryResponses() {
+
+    QFETCH(QByteArray, contents);
+
+    QVector<Response> responses;
+    for (int i = 0; i < 100; ++i) {
+
+        responses.push_back(Response(contents, QList<QNetworkReply::RawHeaderPair>(), QVariant(i)));
+        QVERIFY(responses.last().bodyIsJson());
+    }
+
+    const JsonQuery query(QStringLiteral("Data[?Deleted==false && Hidden!=true].ID"));
+    QVERIFY(query.isValid());
+
+    QVERIFY(!responses.first().query(query).isEmpty());
+
+    QBENCHMARK {
+
+        for (const auto & it: qAsConst(responses))
+            it.query(query);
+    }
+    return;
+}
+
+// the same GET before and after change (records in reversed order, one of them modified)
+void ResponseBenchmark::diffResponses() {
+
+    QFETCH(QByteArray, contents);
+
+    const QJsonObject before = QJsonDocument::fromJson(contents).object();
+    QJsonArray data = before.value(QStringLiteral("Data")).toArray();
+    QVERIFY(!data.isEmpty());
+
+    QJsonArray reversed;
+    for (int i = data.size() - 1; i >= 0; --i)
+        reversed.append(data.at(i));
+    QJsonObject record = reversed.at(0).toObject();
+    record[QStringLiteral("Deleted")] = true;
+    reversed[0] = record;
+
+    QJsonObject after = before;
+    after[QStringLiteral("Data")] = reversed;
+
+    QBENCHMARK {
+
+        const JsonDiff diff(before, after);
+        QVERIFY(!diff.isEqual());
+    }
+    return;
+}
+
+// full-text search in journal of 100 messages (index is loaded by first search, see LogWindow)
+void ResponseBenchmark::searchJournal() {
+
+    QFETCH(QByteArray, contents);
+
+    Journal journal(_variantsDir.filePath(QStringLiteral("journal_") + QString::number(contents.size())));
+    QVERIFY(journal.isOpen());
+
+    for (int i = 0; i < 100; ++i) {
+
+        QNetworkRequest networkRequest(QUrl(QStringLiteral("http://localhost/api/entity") + QString::number(i)));
+        networkRequest.setAttribute(Request::userAttribute(1), i);
+
+        Communication comm(Request(networkRequest, http::GET, QByteArray()));
+        comm.setReply(Response(contents, QList<QNetworkReply::RawHeaderPair>(), i));
+        QVERIFY(journal.append(comm));
+    }
+    QCOMPARE(journal.search(QStringLiteral("ENTITY42"), 10).size(), 1);
+
+    QBENCHMARK {
+
+        QCOMPARE(journal.search(QStringLiteral("entity42"), 10).size(), 1);
+    }
+    return;
+}
+
+// HAR file of 100 entries written and read back entry by entry (see LogWindow)
+void ResponseBenchmark::exportImportHar() {
+
+    QFETCH(QByteArray, contents);
+
+    const QString fileName = _variantsDir.filePath(QStringLiteral("export_") + QString::number(contents.size()) +
+                                                   QStringLiteral(".har"));
+    JournalEntry entry;
+    entry.httpMethod = http::GET;
+    entry.requestType = OTHER;
+    entry.url = QUrl(QStringLiteral("http://localhost/api/entity?from=0"));
+    entry.statusCode = OK;
+    entry.status = QStringLiteral("OK");
+    entry.createDate = QDateTime::currentDateTime();
+
+    QBENCHMARK {
+
+        HarWriter writer(fileName);
+        for (int i = 0; i < 100; ++i) {
+
+            entry.ID = static_cast<quint64>(i);
+            QVERIFY(writer.write(entry, QByteArray(), contents));
+        }
+        QVERIFY(writer.finish());
+
+        HarReader reader(fileName);
+        QByteArray requestBody;
+        QByteArray responseBody;
+        while (reader.next(entry, requestBody, responseBody))
+            QCOMPARE(responseBody.size(), contents.size());
+
+        QVERIFY(!reader.hasError());
+        QCOMPARE(reader.entryCount(), 100);
+    }
+    return;
+}
@@ -0,0 +1,43 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef RESPONSEBENCHMARK_H
+#define RESPONSEBENCHMARK_H
+
+#include <QByteArray>
+#include <QObject>
+#include <QTemporaryDir>
+
+// benchmarks of work with body of GET response (json/getall.json and its larger variant);
+// every case runs with both bodies (see initTestCase_data())
+class ResponseBenchmark: public QObject {
+
+    Q_OBJECT
+
+    private:
+        static QByteArray multiplyData(const QByteArray &, const int);
+
+        QTemporaryDir _variantsDir;
+
+    private slots:
+        void initTestCase_data();
+        void initTestCase();
+
+        void parseBody();
+        void dataFromBody();
+
+        void readDataTable();
+        void sortDataTable();
+
+        void queryResponses();
+
+        void diffResponses();
+
+        void searchJournal();
+
+        void exportImportHar();
+};
+
+#endif // RESPONSEBENCHMARK_H
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QBrush>
+#include <QColor>
+#include "communicationmodel.h"
+
+const int CommunicationModel::cachedResults = 1000;
+
+CommunicationModel::CommunicationModel(Session * const session, QObject * parent):
+    QAbstractTableModel(parent), _session(session), _rowCount(session->communication().size()),
+    _queryResults(cachedResults) {
+
+    connect(_session, &Session::messageAdded, this, &CommunicationModel::addMessage);
+    connect(_session, &Session::messageChanged, this, &CommunicationModel::updateMessage);
+}
+
+int CommunicationModel::rowCount(const QModelIndex & parent) const {
+
+    return (parent.isValid()) ? 0 : _rowCount;
+}
+
+int CommunicationModel::columnCount(const QModelIndex & parent) const {
+
+    return (parent.isValid()) ? 0 : QUERY_RESULT + 1;
+}
+
+QVariant CommunicationModel::data(const QModelIndex & index, int role) const {
+
+    if (!index.isValid() || index.row() >= _rowCount ||
+        (role != Qt::DisplayRole && role != Qt::BackgroundRole && role != Qt::ToolTipRole))
+        return QVariant();
+
+    const Communication & comm = this->communication(index.row());
+
+    // breakdown of duration into phases
+    if (role == Qt::ToolTipRole)
+        return (index.column() == DURATION) ? comm.timing().breakdown() : QVariant();
+    const QString method = http::convertEnumValueToText(comm.request().httpMethod());
+
+    if (role == Qt::BackgroundRole) {
+
+        if (index.column() == ID)
+            return (method.isNull()) ? QVariant() : QBrush(http::httpMethods[method]._color);
+
+        switch (comm.response().statusCode()) {
+            case TEST: return QVariant();
+            case OK: return QBrush(QColor(210,255,166));
+            default: return QBrush(QColor(255,210,210));
+        }
+    }
+
+    switch (index.column()) {
+
+        case ID: return QString::number(comm.ID());
+        case DATE: return comm.createDate().toString("dd.MM.yyyy hh:mm:ss.zzz");
+        case METHOD: return method;
+        case URL: return comm.request().request().url().toDisplayString();
+        case STATUS:
+            return QString::number(static_cast<int>(comm.response().statusCode())) + " " +
+                   comm.response().statusDescription();
+        case DURATION:
+            return (comm.timing().isValid()) ?
+                QString::number(comm.timing().total()) + QStringLiteral(" ms") : QString();
+        case QUERY_RESULT: {
+            if (!_query.isValid())
+                return QVariant();
+            QString * result = _queryResults.object(index.row());
+            if (result == nullptr) {
+
+                result = new QString(JsonQuery::toText(comm.response().query(_query), true));
+                _queryResults.insert(index.row(), result);
+            }
+            return *result;
+        }
+        default: return QVariant();
+    }
+}
+
+QVariant CommunicationModel::headerData(int section, Qt::Orientation orientation, int role) const {
+
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+        return QVariant();
+
+    const QStringList headers =
+        { QStringLiteral("ID"), QStringLiteral("Datum a čas"), QStringLiteral("HTTP metoda"),
+          QStringLiteral("URL adresa"), QStringLiteral("Status"), QStringLiteral("Doba"),
+          QStringLiteral("Výsledek") };
+
+    return headers.value(section);
+}
+
+void CommunicationModel::setQuery(const JsonQuery & query) {
+
+    _query = query;
+    _queryResults.clear();
+
+    if (_rowCount > 0)
+        emit dataChanged(index(0, QUERY_RESULT), index(_rowCount - 1, QUERY_RESULT));
+
+    return;
+}
+
+// [slot]
+void CommunicationModel::addMessage(const int position) {
+
+    if (position < _rowCount)
+        return;
+
+    beginInsertRows(QModelIndex(), _rowCount, position);
+    _rowCount = position + 1;
+    endInsertRows();
+
+    return;
+}
+
+// [slot]
+void CommunicationModel::updateMessage(const int position) {
+
+    if (position < 0 || position >= _rowCount)
+        return;
+
+    _queryResults.remove(position);
+    emit dataChanged(index(position, 0), index(position, QUERY_RESULT));
+
+    return;
+}
@@ -0,0 +1,49 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef COMMUNICATIONMODEL_H
+#define COMMUNICATIONMODEL_H
+
+#include <QAbstractTableModel>
+#include <QCache>
+#include "jsonquery.h"
+#include "session.h"
+
+// table view of session's communication; rows are read straight from Session::communication()
+// (nothing is copied) and added or updated as messages are sent and replies arrive;
+// result of query (if set) is evaluated for visible rows only
+class CommunicationModel: public QAbstractTableModel {
+
+    Q_OBJECT
+
+    public:
+        enum Column { ID = 0, DATE = 1, METHOD = 2, URL = 3, STATUS = 4, DURATION = 5, QUERY_RESULT = 6 };
+        const static int cachedResults;
+
+        explicit CommunicationModel(Session * const, QObject * = nullptr);
+        ~CommunicationModel() {}
+
+        inline const Communication & communication(const int row) const
+            { return _session->communication().at(row); }
+
+        int rowCount(const QModelIndex & = QModelIndex()) const override;
+        int columnCount(const QModelIndex & = QModelIndex()) const override;
+        QVariant data(const QModelIndex &, int = Qt::DisplayRole) const override;
+        QVariant headerData(int, Qt::Orientation, int = Qt::DisplayRole) const override;
+
+        void setQuery(const JsonQuery &);
+
+    private slots:
+        void addMessage(const int);
+        void updateMessage(const int);
+
+    private:
+        Session * const _session;
+        int _rowCount;
+        JsonQuery _query;
+        mutable QCache<int, QString> _queryResults;
+};
+
+#endif // COMMUNICATIONMODEL_H
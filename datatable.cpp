@@ -0,0 +1,242 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <cmath>
+#include "datatable.h"
+#include "jsonscanner.h"
+
+QString DataColumn::text(const int row) const {
+
+    if (this->isNull(row))
+        return QString();
+
+    switch (_type) {
+
+        case BOOL: return (_bools.at(row) > 0) ? QStringLiteral("true") : QStringLiteral("false");
+        case NUMBER: {
+            // integers are shown without exponent (up to 2^53)
+            const double value = _numbers.at(row);
+            if (value == std::floor(value) && std::fabs(value) < 9007199254740992.0)
+                return QString::number(static_cast<qint64>(value));
+            return QString::number(value, 'g', 15);
+        }
+        case STRING: return _dictionary.at(_codes.at(row));
+        default: return QString();
+    }
+}
+
+void DataColumn::setType(const ColumnType type) {
+
+    // previous rows (all of them null) are stored in new type
+    _type = type;
+    switch (_type) {
+
+        case BOOL: _bools.fill(-1, _size); break;
+        case NUMBER: _numbers.fill(qQNaN(), _size); break;
+        case STRING: _codes.fill(-1, _size); break;
+        default: break;
+    }
+    return;
+}
+
+void DataColumn::convertToString() {
+
+    // mixed column (e.g. number and string) is kept as text
+    QVector<QString> values;
+    values.reserve(_size);
+    for (int row = 0; row < _size; ++row)
+        values.push_back(this->text(row));
+
+    QVector<bool> nulls(_size);
+    for (int row = 0; row < _size; ++row)
+        nulls[row] = this->isNull(row);
+
+    _numbers.clear();
+    _bools.clear();
+    const int size = _size;
+    _size = 0;
+    _type = STRING;
+
+    for (int row = 0; row < size; ++row)
+        if (nulls.at(row))
+            this->appendNull();
+        else
+            this->appendString(values.at(row));
+
+    return;
+}
+
+void DataColumn::appendNull() {
+
+    switch (_type) {
+
+        case BOOL: _bools.push_back(-1); break;
+        case NUMBER: _numbers.push_back(qQNaN()); break;
+        case STRING: _codes.push_back(-1); break;
+        default: break;
+    }
+    ++_size;
+    return;
+}
+
+void DataColumn::appendBool(const bool value) {
+
+    if (_type == EMPTY)
+        this->setType(BOOL);
+
+    if (_type != BOOL) {
+        this->appendString(value ? QStringLiteral("true") : QStringLiteral("false"));
+        return;
+    }
+
+    _bools.push_back(value ? 1 : 0);
+    ++_size;
+    return;
+}
+
+void DataColumn::appendNumber(const double value) {
+
+    if (_type == EMPTY)
+        this->setType(NUMBER);
+
+    if (_type != NUMBER) {
+
+        DataColumn number;
+        number.appendNumber(value);
+        this->appendString(number.text(0));
+        return;
+    }
+
+    _numbers.push_back(value);
+    ++_size;
+    return;
+}
+
+void DataColumn::appendString(const QString & value) {
+
+    if (_type == EMPTY)
+        this->setType(STRING);
+    else if (_type != STRING)
+        this->convertToString();
+
+    // every distinct value is stored once
+    int code = _lookup.value(value, -1);
+    if (code == -1) {
+
+        code = _dictionary.size();
+        _dictionary.push_back(value);
+        _lookup.insert(value, code);
+    }
+
+    _codes.push_back(code);
+    ++_size;
+    return;
+}
+
+// reads json array of objects; values of keys missing in some objects are null
+bool DataTable::read(const char * const data, const qint64 size) {
+
+    _columns.clear();
+    _rowCount = 0;
+
+    QHash<QString, int> columnIndex;
+    JsonScanner scanner(data, size);
+    if (!scanner.enterArray())
+        return false;
+
+    QString key;
+    QString value;
+
+    while (scanner.nextElement()) {
+
+        if (!scanner.enterObject())
+            break;
+
+        while (scanner.nextKey(key)) {
+
+            int index = columnIndex.value(key, -1);
+            if (index == -1) {
+
+                index = _columns.size();
+                columnIndex.insert(key, index);
+
+                DataColumn column(key);
+                for (int row = 0; row < _rowCount; ++row)
+                    column.appendNull();
+                _columns.push_back(column);
+            }
+
+            DataColumn & column = _columns[index];
+
+            // duplicate key (the first value is kept)
+            if (column.size() > _rowCount) {
+                scanner.skipValue();
+                continue;
+            }
+
+            qint64 begin = 0;
+            qint64 end = 0;
+
+            switch (scanner.peek()) {
+
+                case '"': {
+                    if (scanner.readString(value))
+                        column.appendString(value);
+                    break;
+                }
+                case 't':
+                case 'f': {
+                    bool boolean = false;
+                    if (scanner.readBool(boolean))
+                        column.appendBool(boolean);
+                    break;
+                }
+                case 'n': {
+                    if (scanner.skipValue())
+                        column.appendNull();
+                    break;
+                }
+                // nested objects and arrays are kept as (raw) text
+                case '{':
+                case '[': {
+                    if (scanner.skipValue(&begin, &end))
+                        column.appendString(QString::fromUtf8(data + begin, static_cast<int>(end - begin)));
+                    break;
+                }
+                default: {
+                    if (!scanner.skipValue(&begin, &end))
+                        break;
+                    bool converted = false;
+                    const double number =
+                        QByteArray::fromRawData(data + begin, static_cast<int>(end - begin)).toDouble(&converted);
+                    if (converted)
+                        column.appendNumber(number);
+                    else
+                        column.appendNull();
+                }
+            }
+        }
+
+        if (scanner.hasError())
+            break;
+
+        ++_rowCount;
+        for (auto & it: _columns)
+            if (it.size() < _rowCount)
+                it.appendNull();
+    }
+
+    if (scanner.hasError()) {
+
+        _columns.clear();
+        _rowCount = 0;
+        return false;
+    }
+
+    for (auto & it: _columns)
+        it.finish();
+
+    return true;
+}
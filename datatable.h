@@ -0,0 +1,89 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef DATATABLE_H
+#define DATATABLE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QtNumeric>
+
+// Data section of GET response (array of flat objects) stored by columns;
+// every key has its own typed column, strings are dictionary-encoded
+class DataColumn {
+
+    public:
+        enum ColumnType { EMPTY = 0, BOOL = 1, NUMBER = 2, STRING = 3 };
+
+        DataColumn(): _type(EMPTY), _size(0) {}
+        explicit DataColumn(const QString & name): _name(name), _type(EMPTY), _size(0) {}
+        ~DataColumn() {}
+
+        inline QString name() const { return _name; }
+        inline ColumnType type() const { return _type; }
+        inline int size() const { return _size; }
+
+        // null: NaN (number), -1 (bool, string code)
+        inline bool isNull(const int row) const;
+        inline double number(const int row) const { return _numbers.at(row); }
+        inline qint8 boolean(const int row) const { return _bools.at(row); }
+        inline int code(const int row) const { return _codes.at(row); }
+        inline const QVector<QString> & dictionary() const { return _dictionary; }
+        QString text(const int) const;
+
+        void appendNull();
+        void appendBool(const bool);
+        void appendNumber(const double);
+        void appendString(const QString &);
+        inline void finish() { _lookup.clear(); _lookup.squeeze(); return; }
+
+    private:
+        void setType(const ColumnType);
+        void convertToString();
+
+        QString _name;
+        ColumnType _type;
+        int _size;
+        QVector<double> _numbers;
+        QVector<qint8> _bools;
+        QVector<int> _codes;
+        QVector<QString> _dictionary;
+        QHash<QString, int> _lookup; // used only while table is read
+};
+
+inline bool DataColumn::isNull(const int row) const {
+
+    switch (_type) {
+
+        case BOOL: return (_bools.at(row) < 0);
+        case NUMBER: return qIsNaN(_numbers.at(row));
+        case STRING: return (_codes.at(row) < 0);
+        default: return true;
+    }
+}
+
+class DataTable {
+
+    public:
+        DataTable(): _rowCount(0) {}
+        ~DataTable() {}
+
+        bool read(const char * const, const qint64);
+        inline bool read(const QByteArray & data) { return read(data.constData(), data.size()); }
+
+        inline bool isEmpty() const { return (_rowCount == 0); }
+        inline int rowCount() const { return _rowCount; }
+        inline int columnCount() const { return _columns.size(); }
+        inline const DataColumn & column(const int index) const { return _columns.at(index); }
+        inline QString text(const int row, const int column) const { return _columns.at(column).text(row); }
+
+    private:
+        QVector<DataColumn> _columns;
+        int _rowCount;
+};
+
+#endif // DATATABLE_H
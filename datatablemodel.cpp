@@ -0,0 +1,165 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <numeric>
+#include "datatablemodel.h"
+
+DataTableModel::DataTableModel(const DataTable & table, QObject * parent):
+    QAbstractTableModel(parent), _table(table), _filterColumn(-1) {
+
+    _order.resize(_table.rowCount());
+    std::iota(_order.begin(), _order.end(), 0);
+    _rows = _order;
+}
+
+int DataTableModel::rowCount(const QModelIndex & parent) const {
+
+    return (parent.isValid()) ? 0 : _rows.size();
+}
+
+int DataTableModel::columnCount(const QModelIndex & parent) const {
+
+    return (parent.isValid()) ? 0 : _table.columnCount();
+}
+
+QVariant DataTableModel::data(const QModelIndex & index, int role) const {
+
+    if (!index.isValid() || index.row() >= _rows.size())
+        return QVariant();
+
+    if (role == Qt::DisplayRole)
+        return _table.text(_rows.at(index.row()), index.column());
+
+    if (role == Qt::TextAlignmentRole && _table.column(index.column()).type() == DataColumn::NUMBER)
+        return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+
+    return QVariant();
+}
+
+QVariant DataTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    // original row number is kept (rows are identified in sorted/filtered table)
+    if (orientation == Qt::Vertical)
+        return (section < _rows.size()) ? QVariant(_rows.at(section) + 1) : QVariant();
+
+    return (section < _table.columnCount()) ? QVariant(_table.column(section).name()) : QVariant();
+}
+
+QVector<int> DataTableModel::dictionaryRanks(const int column) const {
+
+    // distinct values are sorted once, rows are then compared by rank of their value
+    const QVector<QString> & dictionary = _table.column(column).dictionary();
+
+    QVector<int> byValue(dictionary.size());
+    std::iota(byValue.begin(), byValue.end(), 0);
+    std::sort(byValue.begin(), byValue.end(), [&dictionary](const int a, const int b) -> bool
+              { return (QString::localeAwareCompare(dictionary.at(a), dictionary.at(b)) < 0); } );
+
+    QVector<int> ranks(dictionary.size());
+    for (int i = 0; i < byValue.size(); ++i)
+        ranks[byValue.at(i)] = i;
+
+    return ranks;
+}
+
+void DataTableModel::sort(int column, Qt::SortOrder order) {
+
+    if (column < 0 || column >= _table.columnCount())
+        return;
+
+    beginResetModel();
+
+    const DataColumn & data = _table.column(column);
+    std::iota(_order.begin(), _order.end(), 0);
+
+    // null values are placed first (ascending order); rows with equal values keep original order
+    switch (data.type()) {
+
+        case DataColumn::BOOL:
+            std::stable_sort(_order.begin(), _order.end(), [&data](const int a, const int b) -> bool
+                             { return (data.boolean(a) < data.boolean(b)); } );
+            break;
+        case DataColumn::NUMBER:
+            std::stable_sort(_order.begin(), _order.end(), [&data](const int a, const int b) -> bool
+                             { return (data.isNull(a) && !data.isNull(b)) ||
+                                      (!data.isNull(a) && !data.isNull(b) && data.number(a) < data.number(b)); } );
+            break;
+        case DataColumn::STRING: {
+            const QVector<int> ranks = dictionaryRanks(column);
+            std::stable_sort(_order.begin(), _order.end(), [&data, &ranks](const int a, const int b) -> bool
+                             { const int rankA = (data.code(a) < 0) ? -1 : ranks.at(data.code(a));
+                               const int rankB = (data.code(b) < 0) ? -1 : ranks.at(data.code(b));
+                               return (rankA < rankB); } );
+            break;
+        }
+        default: break;
+    }
+
+    if (order == Qt::DescendingOrder)
+        std::reverse(_order.begin(), _order.end());
+
+    this->applyFilter();
+
+    endResetModel();
+    return;
+}
+
+void DataTableModel::setFilter(const int column, const QString & text) {
+
+    beginResetModel();
+
+    _filterColumn = (column < _table.columnCount()) ? column : -1;
+    _filterText = text;
+    this->applyFilter();
+
+    endResetModel();
+    return;
+}
+
+void DataTableModel::applyFilter() {
+
+    if (_filterText.isEmpty()) {
+
+        _rows = _order;
+        return;
+    }
+
+    // string columns: every distinct value is matched once (not every row)
+    const int firstColumn = (_filterColumn < 0) ? 0 : _filterColumn;
+    const int lastColumn = (_filterColumn < 0) ? _table.columnCount() - 1 : _filterColumn;
+
+    QVector<QVector<bool>> matchingCodes(_table.columnCount());
+    for (int column = firstColumn; column <= lastColumn; ++column) {
+
+        const DataColumn & data = _table.column(column);
+        if (data.type() != DataColumn::STRING)
+            continue;
+
+        matchingCodes[column].resize(data.dictionary().size());
+        for (int code = 0; code < data.dictionary().size(); ++code)
+            matchingCodes[column][code] = data.dictionary().at(code).contains(_filterText, Qt::CaseInsensitive);
+    }
+
+    _rows.clear();
+    for (auto row: qAsConst(_order))
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+
+            const DataColumn & data = _table.column(column);
+            const bool matches = (data.type() == DataColumn::STRING)
+                ? (data.code(row) >= 0 && matchingCodes.at(column).at(data.code(row)))
+                : data.text(row).contains(_filterText, Qt::CaseInsensitive);
+
+            if (matches) {
+                _rows.push_back(row);
+                break;
+            }
+        }
+
+    return;
+}
@@ -0,0 +1,47 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef DATATABLEMODEL_H
+#define DATATABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QString>
+#include <QVector>
+#include "datatable.h"
+
+// table view of DataTable; sorting and filtering only reorder (select) row indices,
+// values are never copied (string columns are compared by their dictionary codes)
+class DataTableModel: public QAbstractTableModel {
+
+    Q_OBJECT
+
+    public:
+        explicit DataTableModel(const DataTable &, QObject * = nullptr);
+        ~DataTableModel() {}
+
+        inline int totalRowCount() const { return _table.rowCount(); }
+        inline const DataTable & table() const { return _table; }
+
+        int rowCount(const QModelIndex & = QModelIndex()) const override;
+        int columnCount(const QModelIndex & = QModelIndex()) const override;
+        QVariant data(const QModelIndex &, int = Qt::DisplayRole) const override;
+        QVariant headerData(int, Qt::Orientation, int = Qt::DisplayRole) const override;
+        void sort(int, Qt::SortOrder = Qt::AscendingOrder) override;
+
+        // column -1 = any column
+        void setFilter(const int, const QString &);
+
+    private:
+        QVector<int> dictionaryRanks(const int) const;
+        void applyFilter();
+
+        DataTable _table;
+        QVector<int> _order; // all rows (sorted)
+        QVector<int> _rows;  // rows shown (sorted and filtered)
+        int _filterColumn;
+        QString _filterText;
+};
+
+#endif // DATATABLEMODEL_H
@@ -0,0 +1,43 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include "datatablewindow.h"
+
+DataTableWindow::DataTableWindow(const DataTable & table, const QString & url, QWidget * parent):
+    QDialog(parent), _model(new DataTableModel(table, this)), ui(new Ui_DataTableWindow) {
+
+    ui->setupUi(this, _model, url);
+    this->updateRowCount();
+
+    connect(ui->filterLineEdit, &QLineEdit::textChanged, this, &DataTableWindow::filterRows);
+    connect(ui->filterColumnComboBox, static_cast<void(QComboBox::*)(int)>
+            (&QComboBox::currentIndexChanged), this, &DataTableWindow::filterRows);
+    connect(ui->columnsMenu, &QMenu::triggered, this, &DataTableWindow::showColumn);
+    connect(_model, &DataTableModel::modelReset, this, &DataTableWindow::updateRowCount);
+    connect(ui->closeButton, &QPushButton::clicked, this, &DataTableWindow::close);
+}
+
+// [slot]
+void DataTableWindow::filterRows() {
+
+    // first item of combo box = all columns
+    _model->setFilter(ui->filterColumnComboBox->currentIndex() - 1, ui->filterLineEdit->text());
+    return;
+}
+
+// [slot]
+void DataTableWindow::showColumn(QAction * const column) {
+
+    ui->dataTableView->setColumnHidden(column->data().toInt(), !column->isChecked());
+    return;
+}
+
+// [slot]
+void DataTableWindow::updateRowCount() {
+
+    ui->rowCountLabel->setText(QStringLiteral("řádků: ") + QString::number(_model->rowCount()) +
+                               QStringLiteral(" / ") + QString::number(_model->totalRowCount()));
+    return;
+}
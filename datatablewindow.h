@@ -0,0 +1,32 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef DATATABLEWINDOW_H
+#define DATATABLEWINDOW_H
+
+#include <QWidget>
+#include "datatable.h"
+#include "datatablemodel.h"
+#include "ui/ui_datatablewindow.h"
+
+class DataTableWindow: public QDialog {
+
+    Q_OBJECT
+
+    public:
+        explicit DataTableWindow(const DataTable &, const QString &, QWidget * = nullptr);
+        ~DataTableWindow() { delete ui; }
+
+    private:
+        DataTableModel * _model;
+        Ui_DataTableWindow * ui;
+
+    private slots:
+        void filterRows();
+        void showColumn(QAction * const);
+        void updateRowCount();
+};
+
+#endif // DATATABLEWINDOW_H
@@ -0,0 +1,15 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include "diffwindow.h"
+
+DiffWindow::DiffWindow(const JsonDiff & diff, const QString & beforeTitle,
+                       const QString & afterTitle, QWidget * parent):
+    QDialog(parent), ui(new Ui_DiffWindow) {
+
+    ui->setupUi(this, diff, beforeTitle, afterTitle);
+
+    connect(ui->closeButton, &QPushButton::clicked, this, &DiffWindow::close);
+}
@@ -0,0 +1,25 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef DIFFWINDOW_H
+#define DIFFWINDOW_H
+
+#include <QWidget>
+#include "jsondiff.h"
+#include "ui/ui_diffwindow.h"
+
+class DiffWindow: public QDialog {
+
+    Q_OBJECT
+
+    public:
+        explicit DiffWindow(const JsonDiff &, const QString &, const QString &, QWidget * = nullptr);
+        ~DiffWindow() { delete ui; }
+
+    private:
+        Ui_DiffWindow * ui;
+};
+
+#endif // DIFFWINDOW_H
@@ -3,7 +3,6 @@
  This program is distributed under the terms of the GNU General Public License.
 *******************************************************************************/
 
-#include <QJsonArray>
 #include <QRegularExpressionMatch>
 #include <QRegularExpressionMatchIterator>
 #include <QStringList>
@@ -26,39 +25,8 @@ Endpoint * Endpoint::_currentEndpoint = nullptr;
 
 Endpoint::Endpoint(const QString & path, const QString & method):
     _path(path), _summary(QString()), _httpMethod(method), _dtoLabel(QString()),
-    _parameters(new QVector<Parameters>), _dataTransferObject(new QVector<Attributes>) {}
-
-Endpoint::Endpoint(const Endpoint & e2) {
-
-    _path = e2._path;
-    _summary = e2._summary;
-    _httpMethod = e2._httpMethod;
-    _dtoLabel = e2._dtoLabel;
-
-    _parameters = new(QVector<Parameters>);
-    *(_parameters) = *(e2._parameters);
-
-    _dataTransferObject = new(QVector<Attributes>);
-    *(_dataTransferObject) = *(e2._dataTransferObject);
-}
-
-Endpoint & Endpoint::operator=(const Endpoint & e2) {
-
-    if (this != &e2) {
-
-        _path = e2._path;
-        _summary = e2._summary;
-        _httpMethod = e2._httpMethod;
-        _dtoLabel = e2._dtoLabel;
-
-        _parameters = new(QVector<Parameters>);
-        *(_parameters) = *(e2._parameters);
-
-        _dataTransferObject = new(QVector<Attributes>);
-        *(_dataTransferObject) = *(e2._dataTransferObject);
-    }
-    return (*this);
-}
+    _parameters(QVector<Parameters>()), _dataTransferObject(QVector<Attributes>()),
+    _operationFingerprint(QByteArray()), _dtoFingerprint(QByteArray()) {}
 
 QString Endpoint::pathWithParameters() const {
 
@@ -73,7 +41,7 @@ QString Endpoint::pathWithParameters() const {
         const QRegularExpressionMatch match = allMatches.next();
         const QString pathParam = match.captured();
 
-        for (auto it: *(_parameters))
+        for (auto it: _parameters)
             if (it.name() == pathParam) {
 
                 pathWithParameters.replace(pathParam, it.value().toString());
@@ -86,11 +54,11 @@ QString Endpoint::pathWithParameters() const {
 bool Endpoint::allAttributesSelected() const {
 
     uint16_t noOfSelectedAttributes = 0;
-    for (auto it: *(this->_dataTransferObject))
+    for (auto it: this->_dataTransferObject)
         if (it.useInRequest())
             ++noOfSelectedAttributes;
 
-    return (noOfSelectedAttributes == _dataTransferObject->size());
+    return (noOfSelectedAttributes == _dataTransferObject.size());
 }
 
 QString Endpoint::buildSelectClause() const {
@@ -101,7 +69,7 @@ QString Endpoint::buildSelectClause() const {
     if (this->allAttributesSelected())
         return selectClause;
 
-    for (auto it: *(this->_dataTransferObject))
+    for (auto it: this->_dataTransferObject)
         if (it.useInRequest())
             selectClause += it.name() + QStringLiteral(",");
 
@@ -116,7 +84,7 @@ bool Endpoint::isAtLeastOnePathParameterSupplied() const {
     if (!this->hasPathParams())
         return true;
 
-    for (auto it: *(this->_parameters))
+    for (auto it: this->_parameters)
         if (!it.value().isNull())
             return true;
 
@@ -128,7 +96,7 @@ bool Endpoint::areRequiredPathParamsSupplied() const {
     if (!this->hasPathParams())
         return true;
 
-    for (auto it: *(this->_parameters))
+    for (auto it: this->_parameters)
         if (it.required() && it.value().isNull())
             return false;
 
@@ -141,7 +109,7 @@ bool Endpoint::isAtLeastOneBodyAttributeSupplied() const {
     if (!this->hasBodyAttributes() || !http::httpMethods[_httpMethod.toUpper()]._bodyRequired)
         return true;
 
-    for (auto it: *(this->_dataTransferObject))
+    for (auto it: this->_dataTransferObject)
         if (!it.value().isNull())
             return true;
 
@@ -170,26 +138,21 @@ QStringList Endpoint::extractInputParamsFromPath() const {
     return params;
 }
 
-void Endpoint::setParams(const QJsonObject & method) {
+void Endpoint::setParams(const QVector<Parameters> & operationParams) {
 
-    this->_parameters->clear();
+    this->_parameters.clear();
 
     const QStringList listOfParamNames = extractInputParamsFromPath();
-    const QJsonArray paramsArray = method["parameters"].toArray();
-
-    for (int i = 0; i < paramsArray.size(); ++i) {
 
-        const QJsonObject paramsObject(paramsArray[i].toObject());
+    for (auto it_param: operationParams) {
 
         // path parameters
         for (auto it: listOfParamNames) {
 
-            if (paramsObject["name"].toString() == (it.mid(1,it.length()-2))) {
+            if (it_param.name() == (it.mid(1,it.length()-2))) {
 
-                const bool required = paramsObject["required"].toBool();
-                const QString dataType = this->makeType(paramsObject);
-                const Parameters params(it, required, dataType);
-                this->_parameters->push_back(params);
+                const Parameters params(it, it_param.required(), it_param.type());
+                this->_parameters.push_back(params);
             }
         }
 
@@ -198,79 +161,9 @@ void Endpoint::setParams(const QJsonObject & method) {
     return;
 }
 
-void Endpoint::setDtoInputDefinitionLink(const QJsonObject & method) {
-
-    // for POST/PUT are DTOs under /parameters section
-    const QJsonArray paramsArray = method["parameters"].toArray();
-
-    // definition for standard POST/PUT requests: /items/schema/items/ref
-    // definition for PUT /UpdateCompany request: /item/schema/ref
-    // definition for Request type POST requests: /data/schema/ref
-    // definition for Request type PUT requests: /resultData/schema/ref
-    const QStringList elements = { "items", "item", "data", "resultData" };
-
-    for (int i = 0; i < paramsArray.size(); ++i) {
-
-        const QJsonObject paramsObject(paramsArray[i].toObject());
-
-        if (elements.contains(paramsObject["name"].toString(), Qt::CaseInsensitive)) {
-
-            QJsonObject schemaObject = paramsObject["schema"].toObject();
-            if (schemaObject["items"].isObject())
-                schemaObject = schemaObject["items"].toObject();
-            QString dtoLink = schemaObject["$ref"].toString();
-            dtoLink = dtoLink.right(dtoLink.length() - dtoLink.lastIndexOf('/') - 1);
-            this->_dtoLabel = dtoLink;
-        }
-    }
-    return;
-}
-
-void Endpoint::setDtoOutputDefinitionLink(const QJsonObject & method) {
-
-    // for GET are DTOs under /responses section
-    const QJsonObject respObject = method["responses"].toObject();
-
-    // definition for standard GET requests: /200/schema/items/ref
-    // definition for GET/{id} requests: /200/schema/ref
-
-    QJsonObject schemaObject = respObject["200"].toObject();
-    schemaObject = schemaObject["schema"].toObject();
-    if (schemaObject["items"].isObject())
-        schemaObject = schemaObject["items"].toObject();
-    QString dtoLink = schemaObject["$ref"].toString();
-    dtoLink = dtoLink.right(dtoLink.length() - dtoLink.lastIndexOf('/') - 1);
-    this->_dtoLabel = dtoLink;
-
-    return;
-}
-
-void Endpoint::setDtoAttributes(const QJsonObject & definitions, const http::dataFlow flow) {
-
-    this->_dataTransferObject->clear();
-    if (!definitions[this->_dtoLabel].isObject())
-        return;
-
-    const QJsonObject dtoObject(definitions[this->_dtoLabel].toObject());
-    const QJsonObject propertiesObject = dtoObject["properties"].toObject();
-    const QStringList properties = propertiesObject.keys();
+void Endpoint::setDtoAttributes(const QVector<Attributes> & dtoAttributes) {
 
-    for (auto it: properties) {
-
-        const QJsonObject attributeObject = propertiesObject[it].toObject();
-        const QString dataType = this->makeType(attributeObject);
-        const Attributes dtoAttributes(it, dataType, flow);
-        this->_dataTransferObject->push_back(dtoAttributes);
-    }
+    // assignment only shares the data; it is copied first time an attribute value is set
+    this->_dataTransferObject = dtoAttributes;
     return;
 }
-
-QString Endpoint::makeType(const QJsonObject & params) const {
-
-    QString delimiter = QStringLiteral("/");
-
-    if (params["type"].toString().isEmpty() || params["format"].toString().isEmpty())
-        delimiter.clear();
-
-    return (params["type"].toString() + delimiter + params["format"].toString());
-}
@@ -6,7 +6,7 @@
 #ifndef ENDPOINT_H
 #define ENDPOINT_H
 
-#include <QJsonObject>
+#include <QByteArray>
 #include <QRegularExpression>
 #include <QVariant>
 #include <QVector>
@@ -62,12 +62,11 @@ class Endpoint {
 
     public:
         Endpoint(): _path(QString()), _summary(QString()), _httpMethod(QString()),
-                    _dtoLabel(QString()), _parameters(new QVector<Parameters>),
-                    _dataTransferObject(new QVector<Attributes>) {}
+                    _dtoLabel(QString()), _parameters(QVector<Parameters>()),
+                    _dataTransferObject(QVector<Attributes>()),
+                    _operationFingerprint(QByteArray()), _dtoFingerprint(QByteArray()) {}
         Endpoint(const QString &, const QString &);
-        Endpoint(const Endpoint &);
-        Endpoint & operator=(const Endpoint &);
-        ~Endpoint() { delete _dataTransferObject; delete _parameters; }
+        ~Endpoint() {}
 
         const static QRegularExpression paramsRegex;
 
@@ -77,8 +76,11 @@ class Endpoint {
         inline QString summary() const { return _summary; }
         inline QString method() const { return _httpMethod; }
         inline QString dtoLabel() const { return _dtoLabel; }
-        inline QVector<Parameters> * parameters() const { return _parameters; }
-        inline QVector<Attributes> * attributes() const { return _dataTransferObject; }
+        // copies of endpoint share params and attributes (until one of them is modified)
+        inline const QVector<Parameters> * parameters() const { return &(_parameters); }
+        inline QVector<Parameters> * parameters() { return &(_parameters); }
+        inline const QVector<Attributes> * attributes() const { return &(_dataTransferObject); }
+        inline QVector<Attributes> * attributes() { return &(_dataTransferObject); }
         inline void setSummary(const QString & summary) { _summary = summary; return; }
 
         bool allAttributesSelected() const;
@@ -89,20 +91,27 @@ class Endpoint {
             { Endpoint::_currentEndpoint = endpoint; return; }
         inline static void eraseCurrentEndpoint() { setCurrentEndpoint(); return; }
 
-        inline bool hasPathParams() const { return !(_parameters->isEmpty()); }
+        inline bool hasPathParams() const { return !(_parameters.isEmpty()); }
         bool isAtLeastOnePathParameterSupplied() const;
         bool areRequiredPathParamsSupplied() const;
-        inline bool hasBodyAttributes() const { return !(_dataTransferObject->isEmpty()); }
+        inline bool hasBodyAttributes() const { return !(_dataTransferObject.isEmpty()); }
         bool isAtLeastOneBodyAttributeSupplied() const;
         bool itemNotEligible() const;
         inline bool propertiesAreNotSet() const
             { return (summary().isEmpty() && !hasPathParams() && !hasBodyAttributes()); }
 
         QStringList extractInputParamsFromPath() const;
-        void setParams(const QJsonObject &);
-        void setDtoInputDefinitionLink(const QJsonObject &);
-        void setDtoOutputDefinitionLink(const QJsonObject &);
-        void setDtoAttributes(const QJsonObject &, const http::dataFlow);
+        void setParams(const QVector<Parameters> &);
+        inline void setDtoLabel(const QString & dtoLabel) { _dtoLabel = dtoLabel; return; }
+        void setDtoAttributes(const QVector<Attributes> &);
+
+        // hashes of Swagger operation and DTO the properties were built from
+        inline QByteArray operationFingerprint() const { return _operationFingerprint; }
+        inline QByteArray dtoFingerprint() const { return _dtoFingerprint; }
+        inline void setOperationFingerprint(const QByteArray & fingerprint)
+            { _operationFingerprint = fingerprint; return; }
+        inline void setDtoFingerprint(const QByteArray & fingerprint)
+            { _dtoFingerprint = fingerprint; return; }
 
         inline bool operator<(const Endpoint & rhs) const
             { return std::tie(_path, _httpMethod) < std::tie(rhs._path, rhs._httpMethod); }
@@ -110,14 +119,15 @@ class Endpoint {
             { return std::tie(_path, _httpMethod) == std::tie(rhs._path, rhs._httpMethod); }
 
     private:
-        inline QString makeType(const QJsonObject &) const;
         static Endpoint * _currentEndpoint;
         QString _path;
         QString _summary;
         QString _httpMethod;
         QString _dtoLabel;
-        QVector<Parameters> * _parameters;
-        QVector<Attributes> * _dataTransferObject;
+        QVector<Parameters> _parameters;
+        QVector<Attributes> _dataTransferObject;
+        QByteArray _operationFingerprint;
+        QByteArray _dtoFingerprint;
 };
 
 #endif // ENDPOINT_H
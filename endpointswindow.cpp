@@ -37,7 +37,7 @@ EndpointsWindow::EndpointsWindow(QVector<Endpoint> * endpoints, QWidget * parent
 // [slot]
 void EndpointsWindow::showSummary(QTableWidgetItem * const item) {
 
-    const Endpoint currentEndpoint = this->_endpoints->at(item->row());
+    const Endpoint & currentEndpoint = this->_endpoints->at(item->row());
 
     ui->descriptionTextEdit->setPlainText(currentEndpoint.summary());
     ui->inputParamsPathButton->setEnabled(currentEndpoint.hasPathParams());
@@ -50,7 +50,7 @@ void EndpointsWindow::showSummary(QTableWidgetItem * const item) {
 void EndpointsWindow::enableAcceptRequestButton(QTableWidgetItem * const item) {
 
     bool isCurrentRequestAcceptable = false;
-    const Endpoint currentEndpoint = this->_endpoints->at(item->row());
+    const Endpoint & currentEndpoint = this->_endpoints->at(item->row());
 
     // no params, no attribs
     if (!currentEndpoint.hasPathParams() && !currentEndpoint.hasBodyAttributes())
@@ -128,7 +128,7 @@ void EndpointsWindow::acceptCurrentEndpoint() {
 // [slot]
 int EndpointsWindow::displayPathWindow() {
 
-    const Endpoint currentEndpoint = this->_endpoints->at(ui->endpointsListTable->currentRow());
+    const Endpoint & currentEndpoint = this->_endpoints->at(ui->endpointsListTable->currentRow());
 
     PathWindow pathWindow(currentEndpoint, this);
     return pathWindow.exec();
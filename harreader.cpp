@@ -0,0 +1,163 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QUrlQuery>
+#include "harreader.h"
+
+const QStringList HarReader::skippedHeaders = {
+    QStringLiteral("authorization"), QStringLiteral("host"), QStringLiteral("content-length"),
+    QStringLiteral("connection"), QStringLiteral("accept-encoding"), QStringLiteral("cookie") };
+
+HarReader::HarReader(const QString & fileName): _file(fileName), _mappedFile(nullptr),
+    _scanner(nullptr), _count(0) {
+
+    if (!_file.open(QIODevice::ReadOnly) || _file.size() == 0)
+        return;
+
+    _mappedFile = _file.map(0, _file.size());
+    if (_mappedFile == nullptr)
+        return;
+
+    _scanner = new JsonScanner(reinterpret_cast<const char *>(_mappedFile), _file.size());
+    if (!this->findEntries())
+        _scanner->abort();
+}
+
+HarReader::~HarReader() {
+
+    delete _scanner;
+    if (_mappedFile != nullptr)
+        _file.unmap(_mappedFile);
+}
+
+// scanner is moved to the first element of log.entries
+bool HarReader::findEntries() {
+
+    if (!_scanner->enterObject())
+        return false;
+
+    QString key;
+    while (_scanner->nextKey(key)) {
+
+        if (key != QStringLiteral("log")) {
+            _scanner->skipValue();
+            continue;
+        }
+
+        if (!_scanner->enterObject())
+            return false;
+
+        while (_scanner->nextKey(key)) {
+
+            if (key == QStringLiteral("entries"))
+                return _scanner->enterArray();
+            _scanner->skipValue();
+        }
+        return false;
+    }
+    return false;
+}
+
+QList<QNetworkReply::RawHeaderPair> HarReader::headersFromJson(const QJsonArray & array,
+                                                               const bool request) {
+
+    QList<QNetworkReply::RawHeaderPair> headers;
+    for (const auto it: array) {
+
+        const QJsonObject header = it.toObject();
+        const QString name = header.value(QStringLiteral("name")).toString();
+
+        // http/2 pseudo-headers (:authority, :path, ...) are not headers
+        if (name.isEmpty() || name.startsWith(QLatin1Char(':')) ||
+            (request && skippedHeaders.contains(name.toLower())))
+            continue;
+
+        headers.append(qMakePair(name.toLatin1(), header.value(QStringLiteral("value")).toString().toLatin1()));
+    }
+    return headers;
+}
+
+// returns false at the end of entries (or on error, see hasError())
+bool HarReader::next(JournalEntry & entry, QByteArray & requestBody, QByteArray & responseBody) {
+
+    if (this->hasError() || !_scanner->nextElement())
+        return false;
+
+    qint64 begin = 0;
+    qint64 end = 0;
+    if (!_scanner->skipValue(&begin, &end))
+        return false;
+
+    // only this entry is parsed
+    const QJsonObject harEntry = QJsonDocument::fromJson(QByteArray::fromRawData(
+        _scanner->data() + begin, static_cast<int>(end - begin))).object();
+    if (harEntry.isEmpty()) {
+
+        _scanner->abort();
+        return false;
+    }
+    ++_count;
+
+    const QJsonObject request = harEntry.value(QStringLiteral("request")).toObject();
+    const QJsonObject response = harEntry.value(QStringLiteral("response")).toObject();
+    const QJsonObject content = response.value(QStringLiteral("content")).toObject();
+    const QJsonObject timings = harEntry.value(QStringLiteral("timings")).toObject();
+
+    const QString method = request.value(QStringLiteral("method")).toString().toUpper();
+    const int requestType = harEntry.value(QStringLiteral("_requestType")).toInt(OTHER);
+
+    entry.ID = (harEntry.contains(QStringLiteral("_id"))) ?
+        static_cast<quint64>(harEntry.value(QStringLiteral("_id")).toDouble()) : static_cast<quint64>(_count);
+    entry.createDate = QDateTime::fromString(harEntry.value(QStringLiteral("startedDateTime")).toString(),
+                                             Qt::ISODateWithMs).toLocalTime();
+    entry.httpMethod = (http::httpMethods.contains(method)) ? http::httpMethods[method]._method : http::UNKNOWN;
+    entry.requestType = (requestType >= API && requestType <= PAGE) ? static_cast<RequestType>(requestType) : OTHER;
+    entry.url = QUrl(request.value(QStringLiteral("url")).toString());
+    entry.requestHeaders = headersFromJson(request.value(QStringLiteral("headers")).toArray(), true);
+    entry.statusCode = static_cast<StatusCode>(response.value(QStringLiteral("status")).toInt());
+    entry.status = response.value(QStringLiteral("statusText")).toString();
+    entry.responseHeaders = headersFromJson(response.value(QStringLiteral("headers")).toArray(), false);
+    entry.requestBodyOffset = -1;
+    entry.requestBodyLength = 0;
+    entry.responseBodyOffset = -1;
+    entry.responseBodyLength = 0;
+
+    // posted form without text is sent url-encoded
+    const QJsonObject postData = request.value(QStringLiteral("postData")).toObject();
+    if (postData.contains(QStringLiteral("text")))
+        requestBody = postData.value(QStringLiteral("text")).toString().toUtf8();
+    else {
+
+        QUrlQuery form;
+        for (const auto it: postData.value(QStringLiteral("params")).toArray())
+            form.addQueryItem(it.toObject().value(QStringLiteral("name")).toString(),
+                              it.toObject().value(QStringLiteral("value")).toString());
+        requestBody = form.query(QUrl::FullyEncoded).toUtf8();
+    }
+
+    const QString text = content.value(QStringLiteral("text")).toString();
+    responseBody = (content.value(QStringLiteral("encoding")).toString() == QStringLiteral("base64")) ?
+        QByteArray::fromBase64(text.toLatin1()) : text.toUtf8();
+
+    // connection phases (blocked, dns, connect incl. ssl) count as sending (see RequestTiming)
+    const auto phase = [&timings](const QString & name) {
+        return qMax(static_cast<qint64>(timings.value(name).toDouble(-1)), Q_INT64_C(0)); };
+    const qint64 sending = phase(QStringLiteral("blocked")) + phase(QStringLiteral("dns")) +
+                           phase(QStringLiteral("connect")) + phase(QStringLiteral("send"));
+
+    entry.timing = RequestTiming();
+    if (entry.createDate.isValid() && !timings.isEmpty()) {
+
+        entry.timing.queued = entry.createDate.toMSecsSinceEpoch();
+        entry.timing.sent = entry.timing.queued + sending;
+        entry.timing.firstByte = entry.timing.sent + phase(QStringLiteral("wait"));
+        entry.timing.lastByte = entry.timing.firstByte + phase(QStringLiteral("receive"));
+        entry.timing.processed = entry.timing.lastByte +
+            qMax(static_cast<qint64>(harEntry.value(QStringLiteral("_processing")).toDouble(0)), Q_INT64_C(0));
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef HARREADER_H
+#define HARREADER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include "journal.h"
+#include "jsonscanner.h"
+
+// HAR 1.2 file read entry by entry: file is memory-mapped and scanned (JsonScanner),
+// only current entry is parsed; entries are converted to JournalEntry (see HarWriter)
+class HarReader {
+
+    public:
+        // request headers which are not stored (they would be wrong on replay)
+        const static QStringList skippedHeaders;
+
+        explicit HarReader(const QString &);
+        ~HarReader();
+
+        inline bool isOpen() const { return (_scanner != nullptr); }
+        inline bool hasError() const { return (_scanner == nullptr || _scanner->hasError()); }
+        inline int entryCount() const { return _count; }
+        // read part of file in per mille
+        inline int progress() const
+            { return (_scanner == nullptr || _scanner->size() == 0) ? 1000 :
+                     static_cast<int>(_scanner->position() * 1000 / _scanner->size()); }
+
+        bool next(JournalEntry &, QByteArray &, QByteArray &);
+
+    private:
+        static QList<QNetworkReply::RawHeaderPair> headersFromJson(const QJsonArray &, const bool);
+        bool findEntries();
+
+        QFile _file;
+        uchar * _mappedFile;
+        JsonScanner * _scanner;
+        int _count;
+};
+
+#endif // HARREADER_H
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QUrlQuery>
+#include "harwriter.h"
+
+HarWriter::HarWriter(const QString & fileName): _file(fileName), _count(0), _failed(false) {
+
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return;
+
+    QJsonObject creator;
+    creator[QStringLiteral("name")] = QStringLiteral("TAPI");
+    creator[QStringLiteral("version")] = QCoreApplication::applicationVersion();
+
+    // log is opened here and closed by finish(), entries are written in between
+    this->writeText(QByteArrayLiteral("{\"log\":{\"version\":\"1.2\",\"creator\":") +
+                    QJsonDocument(creator).toJson(QJsonDocument::Compact) +
+                    QByteArrayLiteral(",\"entries\":[\n"));
+}
+
+HarWriter::~HarWriter() {
+
+    if (_file.isOpen())
+        this->finish();
+}
+
+bool HarWriter::writeText(const QByteArray & text) {
+
+    if (!_failed && _file.write(text) != text.size())
+        _failed = true;
+
+    return !_failed;
+}
+
+QJsonArray HarWriter::headersToJson(const QList<QNetworkReply::RawHeaderPair> & headers) {
+
+    QJsonArray array;
+    for (const auto & it: headers) {
+
+        QJsonObject header;
+        header[QStringLiteral("name")] = QString::fromLatin1(it.first);
+        header[QStringLiteral("value")] = QString::fromLatin1(it.second);
+        array.append(header);
+    }
+    return array;
+}
+
+QString HarWriter::mimeType(const QList<QNetworkReply::RawHeaderPair> & headers) {
+
+    for (const auto & it: headers)
+        if (it.first.toLower() == QByteArrayLiteral("content-type"))
+            return QString::fromLatin1(it.second);
+
+    return QString();
+}
+
+bool HarWriter::write(const JournalEntry & entry, const QByteArray & requestBody,
+                      const QByteArray & responseBody) {
+
+    if (!this->isOpen())
+        return false;
+
+    // request
+    QJsonArray queryString;
+    for (const auto & it: QUrlQuery(entry.url).queryItems(QUrl::FullyDecoded)) {
+
+        QJsonObject parameter;
+        parameter[QStringLiteral("name")] = it.first;
+        parameter[QStringLiteral("value")] = it.second;
+        queryString.append(parameter);
+    }
+
+    QJsonObject request;
+    request[QStringLiteral("method")] = http::convertEnumValueToText(entry.httpMethod);
+    request[QStringLiteral("url")] = entry.url.toString(QUrl::FullyEncoded);
+    request[QStringLiteral("httpVersion")] = QStringLiteral("HTTP/1.1");
+    request[QStringLiteral("cookies")] = QJsonArray();
+    request[QStringLiteral("headers")] = headersToJson(entry.requestHeaders);
+    request[QStringLiteral("queryString")] = queryString;
+    if (!requestBody.isEmpty()) {
+
+        QJsonObject postData;
+        postData[QStringLiteral("mimeType")] = mimeType(entry.requestHeaders);
+        postData[QStringLiteral("text")] = QString::fromUtf8(requestBody);
+        request[QStringLiteral("postData")] = postData;
+    }
+    request[QStringLiteral("headersSize")] = -1;
+    request[QStringLiteral("bodySize")] = requestBody.size();
+
+    // response (body which is not valid utf-8 is encoded)
+    const QString responseText = QString::fromUtf8(responseBody);
+    const bool binary = (responseText.toUtf8() != responseBody);
+
+    QJsonObject content;
+    content[QStringLiteral("size")] = responseBody.size();
+    content[QStringLiteral("mimeType")] = mimeType(entry.responseHeaders);
+    if (!responseBody.isEmpty()) {
+
+        content[QStringLiteral("text")] =
+            (binary) ? QString::fromLatin1(responseBody.toBase64()) : responseText;
+        if (binary)
+            content[QStringLiteral("encoding")] = QStringLiteral("base64");
+    }
+
+    QJsonObject response;
+    response[QStringLiteral("status")] = static_cast<int>(entry.statusCode);
+    response[QStringLiteral("statusText")] = entry.status;
+    response[QStringLiteral("httpVersion")] = QStringLiteral("HTTP/1.1");
+    response[QStringLiteral("cookies")] = QJsonArray();
+    response[QStringLiteral("headers")] = headersToJson(entry.responseHeaders);
+    response[QStringLiteral("content")] = content;
+    response[QStringLiteral("redirectURL")] = QString();
+    response[QStringLiteral("headersSize")] = -1;
+    response[QStringLiteral("bodySize")] = responseBody.size();
+
+    // timings (unknown sending phase is included in waiting, see RequestTiming)
+    const RequestTiming & timing = entry.timing;
+    const qint64 send = qMax(timing.sending(), Q_INT64_C(0));
+    const qint64 wait = qMax(timing.waiting(), Q_INT64_C(0));
+    const qint64 receive = qMax(timing.receiving(), Q_INT64_C(0));
+
+    QJsonObject timings;
+    timings[QStringLiteral("blocked")] = -1;
+    timings[QStringLiteral("dns")] = -1;
+    timings[QStringLiteral("connect")] = -1;
+    timings[QStringLiteral("send")] = static_cast<double>(send);
+    timings[QStringLiteral("wait")] = static_cast<double>(wait);
+    timings[QStringLiteral("receive")] = static_cast<double>(receive);
+    timings[QStringLiteral("ssl")] = -1;
+
+    const QDateTime started =
+        (timing.queued > 0) ? QDateTime::fromMSecsSinceEpoch(timing.queued) : entry.createDate;
+
+    QJsonObject harEntry;
+    harEntry[QStringLiteral("startedDateTime")] = started.toUTC().toString(Qt::ISODateWithMs);
+    harEntry[QStringLiteral("time")] = static_cast<double>(send + wait + receive);
+    harEntry[QStringLiteral("request")] = request;
+    harEntry[QStringLiteral("response")] = response;
+    harEntry[QStringLiteral("cache")] = QJsonObject();
+    harEntry[QStringLiteral("timings")] = timings;
+    // custom fields (see HarReader)
+    harEntry[QStringLiteral("_id")] = static_cast<double>(entry.ID);
+    harEntry[QStringLiteral("_requestType")] = static_cast<int>(entry.requestType);
+    harEntry[QStringLiteral("_processing")] = static_cast<double>(timing.processing());
+
+    const QByteArray separator = (_count > 0) ? QByteArrayLiteral(",\n") : QByteArray();
+    if (!this->writeText(separator + QJsonDocument(harEntry).toJson(QJsonDocument::Compact)))
+        return false;
+
+    ++_count;
+    return true;
+}
+
+bool HarWriter::finish() {
+
+    if (!_file.isOpen())
+        return false;
+
+    this->writeText(QByteArrayLiteral("\n]}}\n"));
+    _file.close();
+
+    return (!_failed && _file.error() == QFileDevice::NoError);
+}
@@ -0,0 +1,40 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef HARWRITER_H
+#define HARWRITER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include "journal.h"
+
+// HAR 1.2 file written entry by entry (only current entry is held in memory);
+// timing phases are mapped to send/wait/receive, processing is kept in custom field
+class HarWriter {
+
+    public:
+        explicit HarWriter(const QString &);
+        ~HarWriter();
+
+        inline bool isOpen() const { return (_file.isOpen() && !_failed); }
+        inline int entryCount() const { return _count; }
+
+        bool write(const JournalEntry &, const QByteArray &, const QByteArray &);
+        bool finish();
+
+    private:
+        static QJsonArray headersToJson(const QList<QNetworkReply::RawHeaderPair> &);
+        static QString mimeType(const QList<QNetworkReply::RawHeaderPair> &);
+        bool writeText(const QByteArray &);
+
+        QFile _file;
+        int _count;
+        bool _failed;
+};
+
+#endif // HARWRITER_H
@@ -0,0 +1,310 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include "journal.h"
+
+const QString Journal::journalFileName = QStringLiteral("requests.jsonl");
+const QString Journal::bodiesFileName = QStringLiteral("requests.bodies");
+const QString Journal::indexFileName = QStringLiteral("requests.index");
+const QString Journal::textIndexFileName = QStringLiteral("requests.trigrams");
+
+Journal::Journal(const QString & directory):
+    _directory((directory.isEmpty()) ? QStandardPaths::writableLocation(
+                   QStandardPaths::AppLocalDataLocation) + QStringLiteral("/journal") : directory),
+    _textIndex(nullptr), _open(false), _count(0), _mappedIndex(nullptr), _mappedCount(0) {
+
+    if (!QDir().mkpath(_directory))
+        return;
+
+    _journal.setFileName(_directory + QLatin1Char('/') + journalFileName);
+    _bodies.setFileName(_directory + QLatin1Char('/') + bodiesFileName);
+    _index.setFileName(_directory + QLatin1Char('/') + indexFileName);
+
+    _open = (_journal.open(QIODevice::ReadWrite) && _bodies.open(QIODevice::ReadWrite) &&
+             _index.open(QIODevice::ReadWrite));
+    if (!_open)
+        return;
+
+    // incomplete offset (interrupted write) is dropped; lines without offset are never read
+    const qint64 indexSize = _index.size() - (_index.size() % sizeof(qint64));
+    if (indexSize != _index.size())
+        _index.resize(indexSize);
+
+    _count = indexSize / static_cast<qint64>(sizeof(qint64));
+    _textIndex = new TrigramIndex(_directory + QLatin1Char('/') + textIndexFileName);
+}
+
+Journal::~Journal() {
+
+    if (_mappedIndex != nullptr)
+        _index.unmap(_mappedIndex);
+    delete _textIndex;
+}
+
+QJsonArray Journal::headersToJson(const QList<QNetworkReply::RawHeaderPair> & headers) {
+
+    QJsonArray array;
+    for (const auto & it: headers)
+        array.append(QJsonArray({ QString::fromLatin1(it.first), QString::fromLatin1(it.second) }));
+
+    return array;
+}
+
+QList<QNetworkReply::RawHeaderPair> Journal::headersFromJson(const QJsonArray & array) {
+
+    QList<QNetworkReply::RawHeaderPair> headers;
+    for (const auto it: array) {
+
+        const QJsonArray header = it.toArray();
+        headers.append(qMakePair(header.at(0).toString().toLatin1(), header.at(1).toString().toLatin1()));
+    }
+    return headers;
+}
+
+// returns offset of stored body (-1 on failure)
+qint64 Journal::appendBody(const QByteArray & body) {
+
+    const qint64 offset = _bodies.size();
+    if (body.isEmpty())
+        return offset;
+
+    if (!_bodies.seek(offset) || _bodies.write(body) != body.size()) {
+
+        _bodies.resize(offset);
+        return -1;
+    }
+    return offset;
+}
+
+// entry as it is stored (bodies are not part of it, offsets are set by append())
+JournalEntry Journal::toEntry(const Communication & comm) {
+
+    const Request request = comm.request();
+    JournalEntry entry;
+
+    entry.ID = comm.ID();
+    entry.createDate = comm.createDate();
+    entry.httpMethod = request.httpMethod();
+    entry.requestType = static_cast<RequestType>(request.request().attribute(QNetworkRequest::User).toInt());
+    entry.url = request.request().url();
+
+    // access token is not stored (replayed requests get a fresh one)
+    for (const auto & it: request.request().rawHeaderList())
+        if (it.toLower() != QByteArrayLiteral("authorization"))
+            entry.requestHeaders.append(qMakePair(it, request.request().rawHeader(it)));
+
+    entry.requestBodyOffset = -1;
+    entry.requestBodyLength = 0;
+    entry.statusCode = comm.response().statusCode();
+    entry.status = comm.response().statusDescription();
+    entry.responseHeaders = comm.response().headers();
+    entry.responseBodyOffset = -1;
+    entry.responseBodyLength = 0;
+    entry.timing = comm.timing();
+
+    return entry;
+}
+
+bool Journal::append(const Communication & comm) {
+
+    const JournalEntry entry = toEntry(comm);
+    if (!isStorable(entry))
+        return false;
+
+    return this->append(entry, comm.request().body(), comm.response().response());
+}
+
+// entry received from elsewhere (e.g. imported from HAR file) is stored the same way as own message
+bool Journal::append(const JournalEntry & entry, const QByteArray & requestBody,
+                     const QByteArray & responseBody) {
+
+    if (!_open || !isStorable(entry))
+        return false;
+
+    const qint64 requestBodyOffset = this->appendBody(requestBody);
+    const qint64 responseBodyOffset = this->appendBody(responseBody);
+    if (requestBodyOffset < 0 || responseBodyOffset < 0)
+        return false;
+
+    QJsonObject line;
+    line[QStringLiteral("ID")] = static_cast<double>(entry.ID);
+    line[QStringLiteral("Date")] = entry.createDate.toString(Qt::ISODateWithMs);
+    line[QStringLiteral("Method")] = http::convertEnumValueToText(entry.httpMethod);
+    line[QStringLiteral("Type")] = static_cast<int>(entry.requestType);
+    line[QStringLiteral("Url")] = entry.url.toString(QUrl::FullyEncoded);
+    line[QStringLiteral("RequestHeaders")] = headersToJson(entry.requestHeaders);
+    line[QStringLiteral("RequestBody")] =
+        QJsonArray({ static_cast<double>(requestBodyOffset), requestBody.size() });
+    line[QStringLiteral("StatusCode")] = static_cast<int>(entry.statusCode);
+    line[QStringLiteral("Status")] = entry.status;
+    line[QStringLiteral("ResponseHeaders")] = headersToJson(entry.responseHeaders);
+    line[QStringLiteral("ResponseBody")] =
+        QJsonArray({ static_cast<double>(responseBodyOffset), responseBody.size() });
+    const RequestTiming & timing = entry.timing;
+    line[QStringLiteral("Timing")] =
+        QJsonArray({ static_cast<double>(timing.queued), static_cast<double>(timing.sent),
+                     static_cast<double>(timing.firstByte), static_cast<double>(timing.lastByte),
+                     static_cast<double>(timing.processed) });
+
+    const QByteArray contents = QJsonDocument(line).toJson(QJsonDocument::Compact) + '\n';
+    const qint64 lineOffset = _journal.size();
+
+    if (!_journal.seek(lineOffset) || _journal.write(contents) != contents.size()) {
+
+        _journal.resize(lineOffset);
+        return false;
+    }
+
+    // entry becomes visible once its offset is written
+    char offset[sizeof(qint64)];
+    memcpy(offset, &lineOffset, sizeof(offset));
+    if (!_index.seek(_count * static_cast<qint64>(sizeof(qint64))) ||
+        _index.write(offset, sizeof(offset)) != sizeof(offset)) {
+
+        _index.resize(_count * static_cast<qint64>(sizeof(qint64)));
+        _journal.resize(lineOffset);
+        return false;
+    }
+
+    _bodies.flush();
+    _journal.flush();
+    _index.flush();
+    ++_count;
+
+    // texts are indexed while they are in memory (failure is repaired by next search())
+    _textIndex->add(static_cast<quint32>(_count - 1), { contents, requestBody, responseBody });
+
+    return true;
+}
+
+// index is mapped again only when entry beyond mapped part is requested
+qint64 Journal::lineOffset(const qint64 number) {
+
+    if (number < 0 || number >= _count)
+        return -1;
+
+    if (number >= _mappedCount) {
+
+        if (_mappedIndex != nullptr)
+            _index.unmap(_mappedIndex);
+
+        _mappedIndex = _index.map(0, _count * static_cast<qint64>(sizeof(qint64)));
+        _mappedCount = (_mappedIndex != nullptr) ? _count : 0;
+        if (_mappedIndex == nullptr)
+            return -1;
+    }
+
+    qint64 offset = 0;
+    memcpy(&offset, _mappedIndex + number * static_cast<qint64>(sizeof(qint64)), sizeof(offset));
+    return offset;
+}
+
+QByteArray Journal::line(const qint64 number) {
+
+    const qint64 offset = this->lineOffset(number);
+    if (offset < 0 || !_journal.seek(offset))
+        return QByteArray();
+
+    return _journal.readLine();
+}
+
+bool Journal::entry(const qint64 number, JournalEntry & entry) {
+
+    const QJsonObject line = QJsonDocument::fromJson(this->line(number)).object();
+    if (line.isEmpty())
+        return false;
+
+    const QJsonArray requestBody = line.value(QStringLiteral("RequestBody")).toArray();
+    const QJsonArray responseBody = line.value(QStringLiteral("ResponseBody")).toArray();
+
+    entry.ID = static_cast<quint64>(line.value(QStringLiteral("ID")).toDouble());
+    entry.createDate = QDateTime::fromString(line.value(QStringLiteral("Date")).toString(), Qt::ISODateWithMs);
+    const QString method = line.value(QStringLiteral("Method")).toString();
+    entry.httpMethod = (http::httpMethods.contains(method)) ? http::httpMethods[method]._method : http::UNKNOWN;
+    entry.requestType = static_cast<RequestType>(line.value(QStringLiteral("Type")).toInt());
+    entry.url = QUrl(line.value(QStringLiteral("Url")).toString(), QUrl::StrictMode);
+    entry.requestHeaders = headersFromJson(line.value(QStringLiteral("RequestHeaders")).toArray());
+    entry.requestBodyOffset = static_cast<qint64>(requestBody.at(0).toDouble());
+    entry.requestBodyLength = static_cast<qint64>(requestBody.at(1).toDouble());
+    entry.statusCode = static_cast<StatusCode>(line.value(QStringLiteral("StatusCode")).toInt());
+    entry.status = line.value(QStringLiteral("Status")).toString();
+    entry.responseHeaders = headersFromJson(line.value(QStringLiteral("ResponseHeaders")).toArray());
+    entry.responseBodyOffset = static_cast<qint64>(responseBody.at(0).toDouble());
+    entry.responseBodyLength = static_cast<qint64>(responseBody.at(1).toDouble());
+    // entries written before timing was recorded have none
+    const QJsonArray timing = line.value(QStringLiteral("Timing")).toArray();
+    entry.timing.queued = static_cast<qint64>(timing.at(0).toDouble());
+    entry.timing.sent = static_cast<qint64>(timing.at(1).toDouble());
+    entry.timing.firstByte = static_cast<qint64>(timing.at(2).toDouble());
+    entry.timing.lastByte = static_cast<qint64>(timing.at(3).toDouble());
+    entry.timing.processed = static_cast<qint64>(timing.at(4).toDouble());
+
+    return true;
+}
+
+QByteArray Journal::body(const qint64 offset, const qint64 length) {
+
+    if (!_open || length <= 0 || !_bodies.seek(offset))
+        return QByteArray();
+
+    return _bodies.read(length);
+}
+
+// entry appended while index was not available (or before index existed)
+bool Journal::indexEntry(const qint64 number) {
+
+    JournalEntry current;
+    const QByteArray contents = this->line(number);
+    if (contents.isEmpty() || !this->entry(number, current))
+        return false;
+
+    return _textIndex->add(static_cast<quint32>(number),
+        { contents, this->body(current.requestBodyOffset, current.requestBodyLength),
+          this->body(current.responseBodyOffset, current.responseBodyLength) });
+}
+
+// candidate found by index is confirmed by its texts (query is normalized)
+bool Journal::matches(const qint64 number, const QByteArray & query) {
+
+    if (TrigramIndex::normalized(this->line(number)).contains(query))
+        return true;
+
+    JournalEntry current;
+    if (!this->entry(number, current))
+        return false;
+
+    return (TrigramIndex::normalized(this->body(current.requestBodyOffset, current.requestBodyLength)).contains(query) ||
+            TrigramIndex::normalized(this->body(current.responseBodyOffset, current.responseBodyLength)).contains(query));
+}
+
+// numbers of (at most maxResults newest) entries whose url, headers or bodies contain text
+// (case-insensitive for ascii letters); text shorter than TrigramIndex::minQueryLength finds nothing
+QVector<qint64> Journal::search(const QString & text, const int maxResults) {
+
+    QVector<qint64> result;
+    if (!_open || !_textIndex->load())
+        return result;
+
+    // index covers leading entries => only entries appended while it was not available are indexed
+    for (qint64 i = _textIndex->entryCount(); i < _count; ++i)
+        if (!this->indexEntry(i))
+            break;
+
+    const QVector<quint32> candidates = _textIndex->candidates(text);
+    const QByteArray query = TrigramIndex::normalized(text.toUtf8());
+
+    for (int i = candidates.size() - 1; i >= 0 && result.size() < maxResults; --i)
+        if (this->matches(candidates.at(i), query))
+            result.push_back(candidates.at(i));
+
+    std::reverse(result.begin(), result.end());
+    return result;
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QList>
+#include <QNetworkReply>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+#include "methods.h"
+#include "request.h"
+#include "trigramindex.h"
+
+struct JournalEntry {
+
+    quint64 ID;
+    QDateTime createDate;
+    http::httpMethodType httpMethod;
+    RequestType requestType;
+    QUrl url;
+    QList<QNetworkReply::RawHeaderPair> requestHeaders;
+    qint64 requestBodyOffset;
+    qint64 requestBodyLength;
+    StatusCode statusCode;
+    QString status;
+    QList<QNetworkReply::RawHeaderPair> responseHeaders;
+    qint64 responseBodyOffset;
+    qint64 responseBodyLength;
+    RequestTiming timing;
+};
+
+// append-only journal of communication kept between sessions:
+// requests.jsonl (one line per message), requests.bodies (request and response bodies
+// referenced by offset) and requests.index (offset of every line, memory-mapped);
+// entries are read on demand => browsing costs the same regardless of journal's size;
+// requests.trigrams (log and segments of postings) holds full-text index of every entry
+// (url, headers and both bodies)
+class Journal {
+
+    public:
+        const static QString journalFileName;
+        const static QString bodiesFileName;
+        const static QString indexFileName;
+        const static QString textIndexFileName;
+
+        explicit Journal(const QString & = QString());
+        ~Journal();
+
+        inline bool isOpen() const { return _open; }
+        inline QString directory() const { return _directory; }
+        inline qint64 entryCount() const { return _count; }
+
+        static JournalEntry toEntry(const Communication &);
+        // token request and reply carry credentials (client secret, access token)
+        // => they are neither stored nor exported (see LogWindow::exportHar())
+        inline static bool isStorable(const JournalEntry & entry) { return (entry.requestType != TOKEN); }
+
+        bool append(const Communication &);
+        bool append(const JournalEntry &, const QByteArray &, const QByteArray &);
+        bool entry(const qint64, JournalEntry &);
+        QByteArray body(const qint64, const qint64);
+        QVector<qint64> search(const QString &, const int);
+
+    private:
+        static QJsonArray headersToJson(const QList<QNetworkReply::RawHeaderPair> &);
+        static QList<QNetworkReply::RawHeaderPair> headersFromJson(const QJsonArray &);
+
+        qint64 appendBody(const QByteArray &);
+        qint64 lineOffset(const qint64);
+        QByteArray line(const qint64);
+        bool indexEntry(const qint64);
+        bool matches(const qint64, const QByteArray &);
+
+        QString _directory;
+        QFile _journal;
+        QFile _bodies;
+        QFile _index;
+        TrigramIndex * _textIndex;
+        bool _open;
+        qint64 _count;
+        uchar * _mappedIndex;
+        qint64 _mappedCount; // number of offsets in mapped part of index
+};
+
+#endif // JOURNAL_H
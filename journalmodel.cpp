@@ -0,0 +1,154 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QBrush>
+#include <QColor>
+#include "journalmodel.h"
+
+const int JournalModel::cachedEntries = 1000;
+
+JournalModel::JournalModel(Journal * const journal, QObject * parent):
+    QAbstractTableModel(parent), _journal(journal),
+    _rowCount((journal != nullptr) ? static_cast<int>(journal->entryCount()) : 0),
+    _filtered(false), _entries(cachedEntries) {}
+
+int JournalModel::rowCount(const QModelIndex & parent) const {
+
+    if (parent.isValid())
+        return 0;
+
+    return (_filtered) ? _filter.size() : _rowCount;
+}
+
+int JournalModel::columnCount(const QModelIndex & parent) const {
+
+    // ID, date and time, http method, url, status, duration
+    return (parent.isValid()) ? 0 : 6;
+}
+
+const JournalEntry * JournalModel::entry(const int row) const {
+
+    if (row < 0 || row >= this->rowCount())
+        return nullptr;
+
+    const qint64 number = (_filtered) ? _filter.at(row) : row;
+    JournalEntry * cached = _entries.object(number);
+    if (cached != nullptr)
+        return cached;
+
+    JournalEntry * read = new JournalEntry;
+    if (!_journal->entry(number, *read)) {
+
+        delete read;
+        return nullptr;
+    }
+
+    _entries.insert(number, read);
+    return read;
+}
+
+QByteArray JournalModel::responseBody(const int row) const {
+
+    const JournalEntry * const current = this->entry(row);
+    if (current == nullptr)
+        return QByteArray();
+
+    return _journal->body(current->responseBodyOffset, current->responseBodyLength);
+}
+
+QVariant JournalModel::data(const QModelIndex & index, int role) const {
+
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::BackgroundRole && role != Qt::ToolTipRole))
+        return QVariant();
+
+    const JournalEntry * const current = this->entry(index.row());
+    if (current == nullptr)
+        return QVariant();
+
+    if (role == Qt::ToolTipRole)
+        return (index.column() == 5) ? current->timing.breakdown() : QVariant();
+
+    const QString method = http::convertEnumValueToText(current->httpMethod);
+
+    if (role == Qt::BackgroundRole) {
+
+        if (index.column() == 0)
+            return (method.isNull()) ? QVariant() : QBrush(http::httpMethods[method]._color);
+
+        switch (current->statusCode) {
+            case TEST: return QVariant();
+            case OK: return QBrush(QColor(210,255,166));
+            default: return QBrush(QColor(255,210,210));
+        }
+    }
+
+    switch (index.column()) {
+
+        case 0: return QString::number(current->ID);
+        case 1: return current->createDate.toString("dd.MM.yyyy hh:mm:ss.zzz");
+        case 2: return method;
+        case 3: return current->url.toDisplayString();
+        case 4: return QString::number(static_cast<int>(current->statusCode)) + " " + current->status;
+        case 5: return (current->timing.isValid()) ?
+                    QString::number(current->timing.total()) + QStringLiteral(" ms") : QString();
+        default: return QVariant();
+    }
+}
+
+QVariant JournalModel::headerData(int section, Qt::Orientation orientation, int role) const {
+
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    if (orientation == Qt::Vertical)
+        return section + 1;
+
+    const QStringList headers =
+        { QStringLiteral("ID"), QStringLiteral("Datum a čas"), QStringLiteral("HTTP metoda"),
+          QStringLiteral("URL adresa"), QStringLiteral("Status"), QStringLiteral("Doba") };
+
+    return headers.value(section);
+}
+
+void JournalModel::setFilter(const QVector<qint64> & entries) {
+
+    beginResetModel();
+    _filter = entries;
+    _filtered = true;
+    endResetModel();
+
+    return;
+}
+
+void JournalModel::clearFilter() {
+
+    if (!_filtered)
+        return;
+
+    beginResetModel();
+    _filter.clear();
+    _filtered = false;
+    _rowCount = (_journal != nullptr) ? static_cast<int>(_journal->entryCount()) : 0;
+    endResetModel();
+
+    return;
+}
+
+// entries appended to journal since last refresh are shown (filtered view is not changed)
+void JournalModel::refresh() {
+
+    if (_filtered)
+        return;
+
+    const int entryCount = (_journal != nullptr) ? static_cast<int>(_journal->entryCount()) : 0;
+    if (entryCount <= _rowCount)
+        return;
+
+    beginInsertRows(QModelIndex(), _rowCount, entryCount - 1);
+    _rowCount = entryCount;
+    endInsertRows();
+
+    return;
+}
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef JOURNALMODEL_H
+#define JOURNALMODEL_H
+
+#include <QAbstractTableModel>
+#include <QCache>
+#include "journal.h"
+
+// table view of Journal; entries are read only for visible rows (recently read are cached);
+// filter limits rows to given entries (e.g. results of Journal::search())
+class JournalModel: public QAbstractTableModel {
+
+    Q_OBJECT
+
+    public:
+        const static int cachedEntries;
+
+        explicit JournalModel(Journal * const, QObject * = nullptr);
+        ~JournalModel() {}
+
+        int rowCount(const QModelIndex & = QModelIndex()) const override;
+        int columnCount(const QModelIndex & = QModelIndex()) const override;
+        QVariant data(const QModelIndex &, int = Qt::DisplayRole) const override;
+        QVariant headerData(int, Qt::Orientation, int = Qt::DisplayRole) const override;
+
+        const JournalEntry * entry(const int) const;
+        QByteArray responseBody(const int) const;
+        inline bool isFiltered() const { return _filtered; }
+        void setFilter(const QVector<qint64> &);
+        void clearFilter();
+        void refresh();
+
+    private:
+        Journal * const _journal;
+        int _rowCount;
+        bool _filtered;
+        QVector<qint64> _filter; // row => entry number
+        mutable QCache<qint64, JournalEntry> _entries; // entry number => entry
+};
+
+#endif // JOURNALMODEL_H
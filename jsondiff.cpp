@@ -0,0 +1,209 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <QHash>
+#include "jsondiff.h"
+
+const QString JsonDiff::idAttribute = QStringLiteral("ID");
+
+JsonDiff::JsonDiff(const QJsonValue & before, const QJsonValue & after) {
+
+    build(before, _before);
+    build(after, _after);
+    this->compare(QString(), before, 0, after, 0);
+}
+
+// FNV-1a (64 bits)
+quint64 JsonDiff::hashString(const QString & text) {
+
+    quint64 hash = Q_UINT64_C(0xcbf29ce484222325);
+    const ushort * data = text.utf16();
+
+    for (int i = 0; i < text.size(); ++i) {
+
+        hash ^= data[i];
+        hash *= Q_UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
+quint64 JsonDiff::build(const QJsonValue & value, HashTree & tree) {
+
+    const int node = tree.hashes.size();
+    tree.hashes.push_back(0);
+    tree.sizes.push_back(1);
+
+    quint64 hash = static_cast<quint64>(value.type());
+
+    switch (value.type()) {
+
+        case QJsonValue::Bool:
+            hash = combine(hash, (value.toBool()) ? 1 : 0);
+            break;
+        case QJsonValue::Double: {
+            const double number = value.toDouble();
+            quint64 bits = 0;
+            memcpy(&bits, &number, sizeof(bits));
+            hash = combine(hash, bits);
+            break;
+        }
+        case QJsonValue::String:
+            hash = combine(hash, hashString(value.toString()));
+            break;
+        case QJsonValue::Array:
+            for (const auto it: value.toArray())
+                hash = combine(hash, build(it, tree));
+            break;
+        case QJsonValue::Object: {
+            const QJsonObject object = value.toObject();
+            for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+
+                hash = combine(hash, hashString(it.key()));
+                hash = combine(hash, build(it.value(), tree));
+            }
+            break;
+        }
+        default: break;
+    }
+
+    tree.hashes[node] = hash;
+    tree.sizes[node] = tree.hashes.size() - node;
+    return hash;
+}
+
+// positions of direct children of node (in the same order as they were hashed)
+QVector<int> JsonDiff::childNodes(const HashTree & tree, const int node, const int count) {
+
+    QVector<int> children;
+    children.reserve(count);
+
+    int child = node + 1;
+    for (int i = 0; i < count; ++i) {
+
+        children.push_back(child);
+        child += tree.sizes.at(child);
+    }
+    return children;
+}
+
+QString JsonDiff::elementPath(const QString & path, const QJsonValue & element, const int index) {
+
+    const QString ID = element.toObject().value(idAttribute).toString();
+    if (!ID.isEmpty())
+        return path + QStringLiteral("[?") + idAttribute + QStringLiteral("=='") + ID + QStringLiteral("']");
+
+    return path + QLatin1Char('[') + QString::number(index) + QLatin1Char(']');
+}
+
+void JsonDiff::compare(const QString & path, const QJsonValue & before, const int beforeNode,
+                       const QJsonValue & after, const int afterNode) {
+
+    // identical subtrees
+    if (_before.hashes.at(beforeNode) == _after.hashes.at(afterNode))
+        return;
+
+    if (before.isObject() && after.isObject())
+        this->compareObjects(path, before.toObject(), beforeNode, after.toObject(), afterNode);
+    else if (before.isArray() && after.isArray())
+        this->compareArrays(path, before.toArray(), beforeNode, after.toArray(), afterNode);
+    else
+        this->addChange(CHANGED, path, before, after);
+
+    return;
+}
+
+// keys of QJsonObject are kept sorted => both objects are merged in single pass
+void JsonDiff::compareObjects(const QString & path, const QJsonObject & before, const int beforeNode,
+                              const QJsonObject & after, const int afterNode) {
+
+    const QVector<int> beforeChildren = childNodes(_before, beforeNode, before.size());
+    const QVector<int> afterChildren = childNodes(_after, afterNode, after.size());
+
+    const QString prefix = (path.isEmpty()) ? QString() : path + QLatin1Char('.');
+    auto itBefore = before.constBegin();
+    auto itAfter = after.constBegin();
+    int i = 0;
+    int j = 0;
+
+    while (itBefore != before.constEnd() || itAfter != after.constEnd()) {
+
+        if (itAfter == after.constEnd() ||
+            (itBefore != before.constEnd() && itBefore.key() < itAfter.key())) {
+
+            this->addChange(REMOVED, prefix + itBefore.key(), itBefore.value(), QJsonValue::Undefined);
+            ++itBefore; ++i;
+        }
+        else if (itBefore == before.constEnd() || itAfter.key() < itBefore.key()) {
+
+            this->addChange(ADDED, prefix + itAfter.key(), QJsonValue::Undefined, itAfter.value());
+            ++itAfter; ++j;
+        }
+        else {
+
+            this->compare(prefix + itBefore.key(), itBefore.value(), beforeChildren.at(i),
+                          itAfter.value(), afterChildren.at(j));
+            ++itBefore; ++i;
+            ++itAfter; ++j;
+        }
+    }
+    return;
+}
+
+// elements with ID are paired by ID, the others by their order
+void JsonDiff::compareArrays(const QString & path, const QJsonArray & before, const int beforeNode,
+                             const QJsonArray & after, const int afterNode) {
+
+    const QVector<int> beforeChildren = childNodes(_before, beforeNode, before.size());
+    const QVector<int> afterChildren = childNodes(_after, afterNode, after.size());
+
+    QHash<QString, int> afterIDs;
+    QVector<int> afterWithoutID;
+    afterIDs.reserve(after.size());
+
+    for (int j = 0; j < after.size(); ++j) {
+
+        const QString ID = after.at(j).toObject().value(idAttribute).toString();
+        if (ID.isEmpty() || afterIDs.contains(ID))
+            afterWithoutID.push_back(j);
+        else
+            afterIDs.insert(ID, j);
+    }
+
+    int nextWithoutID = 0;
+    for (int i = 0; i < before.size(); ++i) {
+
+        const QJsonValue element = before.at(i);
+        const QString ID = element.toObject().value(idAttribute).toString();
+
+        const auto it = (ID.isEmpty()) ? afterIDs.end() : afterIDs.find(ID);
+        if (it != afterIDs.end()) {
+
+            this->compare(elementPath(path, element, i), element, beforeChildren.at(i),
+                          after.at(it.value()), afterChildren.at(it.value()));
+            afterIDs.erase(it);
+        }
+        else if (ID.isEmpty() && nextWithoutID < afterWithoutID.size()) {
+
+            const int j = afterWithoutID.at(nextWithoutID++);
+            this->compare(elementPath(path, element, i), element, beforeChildren.at(i),
+                          after.at(j), afterChildren.at(j));
+        }
+        else
+            this->addChange(REMOVED, elementPath(path, element, i), element, QJsonValue::Undefined);
+    }
+
+    // remaining elements (in their original order)
+    QVector<int> added = afterIDs.values().toVector();
+    for (int k = nextWithoutID; k < afterWithoutID.size(); ++k)
+        added.push_back(afterWithoutID.at(k));
+    std::sort(added.begin(), added.end());
+
+    for (const auto j: qAsConst(added))
+        this->addChange(ADDED, elementPath(path, after.at(j), j), QJsonValue::Undefined, after.at(j));
+
+    return;
+}
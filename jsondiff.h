@@ -0,0 +1,66 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef JSONDIFF_H
+#define JSONDIFF_H
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <QVector>
+
+// structural difference of two json documents; every subtree is hashed beforehand
+// (identical branches are skipped by comparing two numbers), elements of arrays
+// containing objects with ID are aligned by ID (not by position)
+class JsonDiff {
+
+    public:
+        enum ChangeType { ADDED = 0, REMOVED = 1, CHANGED = 2 };
+
+        struct Change {
+
+            ChangeType type;
+            QString path; // usable as JsonQuery expression
+            QJsonValue before;
+            QJsonValue after;
+        };
+
+        static const QString idAttribute;
+
+        JsonDiff(const QJsonValue &, const QJsonValue &);
+        ~JsonDiff() {}
+
+        inline const QVector<Change> & changes() const { return _changes; }
+        inline bool isEqual() const { return _changes.isEmpty(); }
+
+    private:
+        // subtree hashes in pre-order; size = number of nodes in subtree (incl. node itself)
+        struct HashTree {
+
+            QVector<quint64> hashes;
+            QVector<int> sizes;
+        };
+
+        static quint64 build(const QJsonValue &, HashTree &);
+        static quint64 hashString(const QString &);
+        static inline quint64 combine(const quint64 hash, const quint64 value)
+            { return hash ^ (value + Q_UINT64_C(0x9e3779b97f4a7c15) + (hash << 6) + (hash >> 2)); }
+        static QVector<int> childNodes(const HashTree &, const int, const int);
+        static QString elementPath(const QString &, const QJsonValue &, const int);
+
+        void compare(const QString &, const QJsonValue &, const int, const QJsonValue &, const int);
+        void compareObjects(const QString &, const QJsonObject &, const int, const QJsonObject &, const int);
+        void compareArrays(const QString &, const QJsonArray &, const int, const QJsonArray &, const int);
+        inline void addChange(const ChangeType type, const QString & path,
+                              const QJsonValue & before, const QJsonValue & after)
+            { _changes.push_back({ type, path, before, after }); return; }
+
+        HashTree _before;
+        HashTree _after;
+        QVector<Change> _changes;
+};
+
+#endif // JSONDIFF_H
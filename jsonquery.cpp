@@ -0,0 +1,375 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include "jsonquery.h"
+
+JsonQuery::JsonQuery(const QString & expression):
+    _expression(expression.trimmed()), _valid(false), _position(0) {
+
+    _valid = this->compile();
+}
+
+bool JsonQuery::fail(const QString & message) {
+
+    _error = message + QStringLiteral(" (pozice ") + QString::number(_position + 1) + QStringLiteral(")");
+    _steps.clear();
+    return false;
+}
+
+bool JsonQuery::compile() {
+
+    _position = 0;
+    if (_expression.isEmpty())
+        return fail(QStringLiteral("prázdný dotaz"));
+
+    // leading @ (current value) is optional
+    if (current() == QLatin1Char('@'))
+        ++_position;
+
+    bool expectField = (_position == 0);
+
+    while (!atEnd()) {
+
+        skipSpaces();
+        Step step;
+        step.index = 0;
+
+        if (current() == QLatin1Char('[')) {
+
+            ++_position;
+            if (!parseBracket(step))
+                return false;
+        }
+        else {
+
+            if (!expectField) {
+
+                if (current() != QLatin1Char('.'))
+                    return fail(QStringLiteral("očekávána tečka nebo ["));
+                ++_position;
+            }
+
+            if (current() == QLatin1Char('*')) {
+
+                ++_position;
+                step.type = WILDCARD;
+            }
+            else {
+
+                step.type = FIELD;
+                step.name = parseIdentifier();
+                if (step.name.isEmpty())
+                    return fail(QStringLiteral("očekáván název atributu"));
+            }
+        }
+
+        _steps.push_back(step);
+        expectField = false;
+        skipSpaces();
+    }
+    return true;
+}
+
+bool JsonQuery::parseBracket(Step & step) {
+
+    skipSpaces();
+
+    if (current() == QLatin1Char('*')) {
+
+        ++_position;
+        step.type = WILDCARD;
+    }
+    else if (current() == QLatin1Char('?')) {
+
+        ++_position;
+        step.type = FILTER;
+
+        Condition condition;
+        if (!parseCondition(condition))
+            return false;
+        step.conditions.push_back(condition);
+
+        skipSpaces();
+        while (_expression.midRef(_position, 2) == QLatin1String("&&")) {
+
+            _position += 2;
+            if (!parseCondition(condition))
+                return false;
+            step.conditions.push_back(condition);
+            skipSpaces();
+        }
+    }
+    else if (current() == QLatin1Char('\'') || current() == QLatin1Char('"')) {
+
+        step.type = FIELD;
+        if (!parseQuoted(step.name))
+            return false;
+    }
+    else {
+
+        const int start = _position;
+        if (current() == QLatin1Char('-'))
+            ++_position;
+        while (current().isDigit())
+            ++_position;
+
+        bool converted = false;
+        step.type = INDEX;
+        step.index = _expression.mid(start, _position - start).toInt(&converted);
+        if (!converted)
+            return fail(QStringLiteral("očekáván index, * nebo ?podmínka"));
+    }
+
+    skipSpaces();
+    if (current() != QLatin1Char(']'))
+        return fail(QStringLiteral("očekávána ]"));
+    ++_position;
+
+    return true;
+}
+
+bool JsonQuery::parseCondition(Condition & condition) {
+
+    condition.path.clear();
+    condition.op = EXISTS;
+    condition.literal = QJsonValue();
+
+    skipSpaces();
+    if (current() == QLatin1Char('@')) {
+
+        ++_position;
+        if (current() == QLatin1Char('.'))
+            ++_position;
+    }
+
+    // relative path (Deleted, Address.City)
+    while (current().isLetterOrNumber() || current() == QLatin1Char('_')) {
+
+        condition.path.push_back(parseIdentifier());
+        if (current() != QLatin1Char('.'))
+            break;
+        ++_position;
+    }
+
+    skipSpaces();
+    const QStringRef op = _expression.midRef(_position, 2);
+
+    if (op == QLatin1String("==")) condition.op = EQUAL;
+    else if (op == QLatin1String("!=")) condition.op = NOT_EQUAL;
+    else if (op == QLatin1String("<=")) condition.op = LESS_OR_EQUAL;
+    else if (op == QLatin1String(">=")) condition.op = GREATER_OR_EQUAL;
+    else if (current() == QLatin1Char('<')) condition.op = LESS;
+    else if (current() == QLatin1Char('>')) condition.op = GREATER;
+
+    // condition without operator tests presence (and truth) of value
+    if (condition.op == EXISTS)
+        return (!condition.path.isEmpty() || fail(QStringLiteral("očekávána podmínka")));
+
+    _position += (condition.op == LESS || condition.op == GREATER) ? 1 : 2;
+    skipSpaces();
+
+    return parseLiteral(condition.literal);
+}
+
+bool JsonQuery::parseLiteral(QJsonValue & literal) {
+
+    if (current() == QLatin1Char('\'') || current() == QLatin1Char('"') || current() == QLatin1Char('`')) {
+
+        QString text;
+        if (!parseQuoted(text))
+            return false;
+        literal = text;
+        return true;
+    }
+
+    const QString word = parseIdentifier();
+
+    if (word == QStringLiteral("true")) { literal = true; return true; }
+    if (word == QStringLiteral("false")) { literal = false; return true; }
+    if (word == QStringLiteral("null")) { literal = QJsonValue(QJsonValue::Null); return true; }
+
+    // number (identifier characters incl. dot have already been consumed)
+    int end = _position;
+    while (end < _expression.size() && (_expression.at(end).isDigit() ||
+           QStringLiteral("+-.eE").contains(_expression.at(end))))
+        ++end;
+
+    bool converted = false;
+    const double number = (word + _expression.mid(_position, end - _position)).toDouble(&converted);
+    if (!converted)
+        return fail(QStringLiteral("neplatná hodnota"));
+
+    _position = end;
+    literal = number;
+    return true;
+}
+
+QString JsonQuery::parseIdentifier() {
+
+    const int start = _position;
+    while (current().isLetterOrNumber() || current() == QLatin1Char('_'))
+        ++_position;
+
+    return _expression.mid(start, _position - start);
+}
+
+bool JsonQuery::parseQuoted(QString & text) {
+
+    const QChar quote = current();
+    ++_position;
+
+    text.clear();
+    while (!atEnd() && current() != quote) {
+
+        if (current() == QLatin1Char('\\') && _position + 1 < _expression.size())
+            ++_position;
+        text += current();
+        ++_position;
+    }
+
+    if (atEnd())
+        return fail(QStringLiteral("neukončený řetězec"));
+
+    ++_position;
+    return true;
+}
+
+QJsonValue JsonQuery::resolve(const QJsonValue & value, const QVector<QString> & path) {
+
+    QJsonValue result = value;
+    for (const auto & it: path) {
+
+        if (!result.isObject())
+            return QJsonValue(QJsonValue::Undefined);
+        result = result.toObject().value(it);
+    }
+    return result;
+}
+
+bool JsonQuery::matches(const QJsonValue & element, const Condition & condition) {
+
+    const QJsonValue value = resolve(element, condition.path);
+
+    if (condition.op == EXISTS)
+        return !(value.isUndefined() || value.isNull() || (value.isBool() && !value.toBool()) ||
+                 (value.isString() && value.toString().isEmpty()));
+
+    if (condition.op == EQUAL)
+        return (value == condition.literal);
+    if (condition.op == NOT_EQUAL)
+        return (value != condition.literal);
+
+    // ordering is defined for numbers and strings only
+    int comparison = 0;
+    if (value.isDouble() && condition.literal.isDouble()) {
+
+        const double a = value.toDouble();
+        const double b = condition.literal.toDouble();
+        comparison = (a < b) ? -1 : (a > b) ? 1 : 0;
+    }
+    else if (value.isString() && condition.literal.isString())
+        comparison = QString::compare(value.toString(), condition.literal.toString());
+    else
+        return false;
+
+    switch (condition.op) {
+
+        case LESS: return (comparison < 0);
+        case LESS_OR_EQUAL: return (comparison <= 0);
+        case GREATER: return (comparison > 0);
+        case GREATER_OR_EQUAL: return (comparison >= 0);
+        default: return false;
+    }
+}
+
+// after wildcard or filter the rest of query is applied to every selected value (projection)
+QVector<QJsonValue> JsonQuery::evaluate(const QJsonValue & root) const {
+
+    QVector<QJsonValue> current;
+    if (!_valid)
+        return current;
+
+    current.push_back(root);
+    QVector<QJsonValue> next;
+
+    for (const auto & step: _steps) {
+
+        next.clear();
+
+        for (const auto & value: qAsConst(current)) {
+
+            switch (step.type) {
+
+                case FIELD: {
+                    if (!value.isObject())
+                        break;
+                    const QJsonValue field = value.toObject().value(step.name);
+                    if (!field.isUndefined())
+                        next.push_back(field);
+                    break;
+                }
+                case INDEX: {
+                    if (!value.isArray())
+                        break;
+                    const QJsonArray array = value.toArray();
+                    const int index = (step.index < 0) ? array.size() + step.index : step.index;
+                    if (index >= 0 && index < array.size())
+                        next.push_back(array.at(index));
+                    break;
+                }
+                case WILDCARD: {
+                    if (value.isArray())
+                        for (const auto it: value.toArray())
+                            next.push_back(it);
+                    else if (value.isObject())
+                        for (const auto it: value.toObject())
+                            next.push_back(it);
+                    break;
+                }
+                case FILTER: {
+                    if (!value.isArray())
+                        break;
+                    for (const auto it: value.toArray()) {
+
+                        bool passed = true;
+                        for (const auto & condition: step.conditions)
+                            if (!matches(it, condition)) { passed = false; break; }
+                        if (passed)
+                            next.push_back(it);
+                    }
+                    break;
+                }
+            }
+        }
+        current.swap(next);
+    }
+    return current;
+}
+
+// one value per line (objects and arrays are indented) or all values on single line
+QString JsonQuery::toText(const QVector<QJsonValue> & values, const bool singleLine) {
+
+    const QJsonDocument::JsonFormat format = (singleLine) ? QJsonDocument::Compact : QJsonDocument::Indented;
+    QStringList lines;
+
+    for (const auto & it: values) {
+
+        switch (it.type()) {
+
+            case QJsonValue::Object: lines << QJsonDocument(it.toObject()).toJson(format).trimmed(); break;
+            case QJsonValue::Array: lines << QJsonDocument(it.toArray()).toJson(format).trimmed(); break;
+            case QJsonValue::String: lines << it.toString(); break;
+            case QJsonValue::Bool: lines << ((it.toBool()) ? QStringLiteral("true") : QStringLiteral("false")); break;
+            case QJsonValue::Double: lines << QString::number(it.toDouble(), 'g', 15); break;
+            case QJsonValue::Null: lines << QStringLiteral("null"); break;
+            default: break;
+        }
+    }
+    return lines.join((singleLine) ? QStringLiteral(", ") : QStringLiteral("\n"));
+}
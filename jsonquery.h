@@ -0,0 +1,73 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef JSONQUERY_H
+#define JSONQUERY_H
+
+#include <QJsonValue>
+#include <QString>
+#include <QVector>
+
+// JMESPath-like query compiled once and evaluated against any number of (parsed) responses;
+// supported: Data.Name, Data[0], Data[-1], Data[*].ID, Data[?Deleted==false].ID,
+// Data[?Price>=100 && Name!='x'], Data.* and ['key with spaces'];
+// values are shared with evaluated document (no subtree is copied)
+class JsonQuery {
+
+    public:
+        JsonQuery(): _valid(false), _position(0) {}
+        explicit JsonQuery(const QString &);
+        ~JsonQuery() {}
+
+        inline bool isValid() const { return _valid; }
+        inline QString expression() const { return _expression; }
+        inline QString error() const { return _error; }
+
+        QVector<QJsonValue> evaluate(const QJsonValue &) const;
+        static QString toText(const QVector<QJsonValue> &, const bool = false);
+
+    private:
+        enum Operator { EXISTS = 0, EQUAL = 1, NOT_EQUAL = 2, LESS = 3, LESS_OR_EQUAL = 4,
+                        GREATER = 5, GREATER_OR_EQUAL = 6 };
+        enum StepType { FIELD = 0, INDEX = 1, WILDCARD = 2, FILTER = 3 };
+
+        struct Condition {
+
+            QVector<QString> path; // relative to filtered element (empty = element itself)
+            Operator op;
+            QJsonValue literal;
+        };
+
+        struct Step {
+
+            StepType type;
+            QString name;
+            int index;
+            QVector<Condition> conditions; // all of them must hold (&&)
+        };
+
+        bool compile();
+        bool parseBracket(Step &);
+        bool parseCondition(Condition &);
+        bool parseLiteral(QJsonValue &);
+        QString parseIdentifier();
+        bool parseQuoted(QString &);
+        inline void skipSpaces()
+            { while (_position < _expression.size() && _expression.at(_position).isSpace()) ++_position; return; }
+        inline bool atEnd() const { return (_position >= _expression.size()); }
+        inline QChar current() const { return (atEnd()) ? QChar() : _expression.at(_position); }
+        bool fail(const QString &);
+
+        static QJsonValue resolve(const QJsonValue &, const QVector<QString> &);
+        static bool matches(const QJsonValue &, const Condition &);
+
+        QString _expression;
+        QVector<Step> _steps;
+        bool _valid;
+        QString _error;
+        int _position; // used only while compiling
+};
+
+#endif // JSONQUERY_H
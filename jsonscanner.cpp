@@ -0,0 +1,228 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <cstring>
+#include "jsonscanner.h"
+
+JsonScanner::JsonScanner(const char * const data, const qint64 size):
+    _data(data), _size(size), _position(0), _error(false) {}
+
+JsonScanner::JsonScanner(const QByteArray & data):
+    _data(data.constData()), _size(data.size()), _position(0), _error(false) {}
+
+char JsonScanner::peek() {
+
+    skipWhitespace();
+    return (_position < _size) ? _data[_position] : '\0';
+}
+
+bool JsonScanner::expect(const char c) {
+
+    if (peek() != c)
+        return fail();
+
+    ++_position;
+    return true;
+}
+
+bool JsonScanner::enterObject() {
+
+    return expect('{');
+}
+
+// returns false at the end of object (or on error, see hasError());
+// value belonging to the key must be consumed (read or skipped) by the caller
+bool JsonScanner::nextKey(QString & key) {
+
+    if (_error)
+        return false;
+
+    char c = peek();
+    if (c == '}') { ++_position; return false; }
+    if (c == ',') { ++_position; c = peek(); }
+
+    if (c != '"' || !readString(key))
+        return fail();
+
+    return expect(':');
+}
+
+bool JsonScanner::enterArray() {
+
+    return expect('[');
+}
+
+// returns false at the end of array (or on error, see hasError());
+// element must be consumed (read or skipped) by the caller
+bool JsonScanner::nextElement() {
+
+    if (_error)
+        return false;
+
+    char c = peek();
+    if (c == ']') { ++_position; return false; }
+    if (c == ',') { ++_position; c = peek(); }
+
+    if (c == '\0' || c == ']' || c == '}')
+        return fail();
+
+    return true;
+}
+
+bool JsonScanner::readString(QString & value) {
+
+    if (peek() != '"')
+        return fail();
+
+    value.clear();
+    qint64 runStart = ++_position;
+
+    while (_position < _size) {
+
+        const char c = _data[_position];
+
+        if (c == '"') {
+
+            value += QString::fromUtf8(_data + runStart, static_cast<int>(_position - runStart));
+            ++_position;
+            return true;
+        }
+
+        if (c != '\\') { ++_position; continue; }
+
+        // escape sequence
+        value += QString::fromUtf8(_data + runStart, static_cast<int>(_position - runStart));
+        if (_position + 1 >= _size)
+            return fail();
+
+        const char escaped = _data[_position + 1];
+        _position += 2;
+
+        switch (escaped) {
+
+            case '"': value += QLatin1Char('"'); break;
+            case '\\': value += QLatin1Char('\\'); break;
+            case '/': value += QLatin1Char('/'); break;
+            case 'b': value += QLatin1Char('\b'); break;
+            case 'f': value += QLatin1Char('\f'); break;
+            case 'n': value += QLatin1Char('\n'); break;
+            case 'r': value += QLatin1Char('\r'); break;
+            case 't': value += QLatin1Char('\t'); break;
+            case 'u': {
+                if (_position + 4 > _size)
+                    return fail();
+                bool converted = false;
+                const ushort codeUnit =
+                    QByteArray(_data + _position, 4).toUShort(&converted, 16);
+                if (!converted)
+                    return fail();
+                // surrogate pairs are stored as two subsequent code units
+                value += QChar(codeUnit);
+                _position += 4;
+                break;
+            }
+            default: return fail();
+        }
+        runStart = _position;
+    }
+    return fail();
+}
+
+bool JsonScanner::readBool(bool & value) {
+
+    const char c = peek();
+    if (c != 't' && c != 'f')
+        return fail();
+
+    value = (c == 't');
+    return skipLiteral();
+}
+
+bool JsonScanner::skipString() {
+
+    // opening quote has already been checked
+    ++_position;
+
+    while (_position < _size) {
+
+        const char * const quote =
+            static_cast<const char *>(memchr(_data + _position, '"', _size - _position));
+        if (quote == nullptr)
+            break;
+
+        // quote is escaped only if preceded by odd number of backslashes
+        qint64 backslashes = 0;
+        const char * it = quote - 1;
+        while (it >= _data + _position && *it == '\\') { ++backslashes; --it; }
+
+        _position = (quote - _data) + 1;
+        if (backslashes % 2 == 0)
+            return true;
+    }
+    return fail();
+}
+
+bool JsonScanner::skipLiteral() {
+
+    // numbers, true, false, null
+    const qint64 start = _position;
+
+    while (_position < _size) {
+
+        const char c = _data[_position];
+        if (c == ',' || c == '}' || c == ']' || c == ':' || isWhitespace(c))
+            break;
+        ++_position;
+    }
+    return (_position > start) ? true : fail();
+}
+
+bool JsonScanner::skipValue(qint64 * const begin, qint64 * const end) {
+
+    const char first = peek();
+    if (begin != nullptr)
+        *begin = _position;
+
+    bool skipped = false;
+
+    if (first == '"')
+        skipped = skipString();
+    else if (first == '{' || first == '[') {
+
+        // nested containers: only depth is tracked, strings are skipped as a whole
+        int depth = 0;
+        while (_position < _size) {
+
+            const char c = _data[_position];
+
+            if (c == '"') {
+                if (!skipString())
+                    return false;
+                continue;
+            }
+            if (c == '{' || c == '[')
+                ++depth;
+            else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    ++_position;
+                    skipped = true;
+                    break;
+                }
+            }
+            ++_position;
+        }
+        if (!skipped)
+            return fail();
+    }
+    else if (first != '\0')
+        skipped = skipLiteral();
+    else
+        return fail();
+
+    if (end != nullptr)
+        *end = _position;
+
+    return skipped;
+}
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef JSONSCANNER_H
+#define JSONSCANNER_H
+
+#include <QByteArray>
+#include <QString>
+
+// forward-only (pull) reader over raw json text; no DOM is built,
+// values the caller is not interested in are skipped without allocation
+class JsonScanner {
+
+    public:
+        JsonScanner(const char * const, const qint64);
+        explicit JsonScanner(const QByteArray &);
+        ~JsonScanner() {}
+
+        inline qint64 position() const { return _position; }
+        inline qint64 size() const { return _size; }
+        inline bool hasError() const { return _error; }
+        inline const char * data() const { return _data; }
+
+        char peek();
+        inline bool atObject() { return (peek() == '{'); }
+        inline bool atArray() { return (peek() == '['); }
+        inline bool atString() { return (peek() == '"'); }
+
+        bool enterObject();
+        bool nextKey(QString &);
+        bool enterArray();
+        bool nextElement();
+
+        bool readString(QString &);
+        bool readBool(bool &);
+        bool skipValue(qint64 * const = nullptr, qint64 * const = nullptr);
+
+        inline void seek(const qint64 position) { _position = position; return; }
+        inline void abort() { _error = true; return; }
+
+    private:
+        inline void skipWhitespace()
+            { while (_position < _size && isWhitespace(_data[_position])) ++_position; return; }
+        inline static bool isWhitespace(const char c)
+            { return (c == ' ' || c == '\n' || c == '\r' || c == '\t'); }
+        inline bool fail() { _error = true; return false; }
+        bool expect(const char);
+        bool skipString();
+        bool skipLiteral();
+
+        const char * _data;
+        qint64 _size;
+        qint64 _position;
+        bool _error;
+};
+
+#endif // JSONSCANNER_H
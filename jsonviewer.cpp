@@ -0,0 +1,385 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QApplication>
+#include <QClipboard>
+#include <QColor>
+#include <QFontDatabase>
+#include <QKeyEvent>
+#include <QScrollBar>
+#include <cstring>
+#include "jsonviewer.h"
+
+const int JsonViewer::sizeThreshold = 1024 * 1024;
+const int JsonViewer::indentation = 4;
+const int JsonViewer::maxLineLength = 4096;
+
+// bytes indexed at once (the rest is indexed in background, between events)
+const static qint64 chunkSize = 4 * 1024 * 1024;
+const static int margin = 4;
+
+JsonViewer::JsonViewer(QWidget * parent): QAbstractScrollArea(parent),
+    _data(QByteArray()), _begin(0), _end(0), _isJson(false), _indexTimer(new QTimer(this)),
+    _indexPosition(0), _depth(0), _inString(false), _escape(false), _pendingBreak(true),
+    _afterOpen(false), _lineHeight(1), _maxLineWidth(0) {
+
+    this->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    _lineHeight = this->fontMetrics().lineSpacing();
+
+    this->viewport()->setBackgroundRole(QPalette::Base);
+    this->viewport()->setAutoFillBackground(true);
+    this->setFocusPolicy(Qt::StrongFocus);
+
+    _indexTimer->setSingleShot(true);
+    _indexTimer->setInterval(0);
+    connect(_indexTimer, &QTimer::timeout, this, &JsonViewer::indexNextChunk);
+}
+
+void JsonViewer::setContents(const QByteArray & data, const qint64 begin, const qint64 end) {
+
+    _indexTimer->stop();
+
+    // data are shared (not copied), only the part <begin, end) is shown
+    _data = data;
+    _begin = qBound(static_cast<qint64>(0), begin, static_cast<qint64>(_data.size()));
+    _end = (end < 0 || end > _data.size()) ? _data.size() : end;
+    if (_end < _begin)
+        _end = _begin;
+
+    _lineOffsets.clear();
+    _lineDepths.clear();
+    _indexPosition = _begin;
+    _depth = 0;
+    _inString = false;
+    _escape = false;
+    _pendingBreak = true;
+    _afterOpen = false;
+    _maxLineWidth = 0;
+
+    // json is pretty-printed; anything else (xml, html, text) is shown line by line
+    qint64 first = _begin;
+    while (first < _end && isWhitespace(_data.at(static_cast<int>(first))))
+        ++first;
+    _isJson = (first < _end && (_data.at(static_cast<int>(first)) == '{' ||
+                                _data.at(static_cast<int>(first)) == '['));
+    if (!_isJson && _begin < _end)
+        this->addLine(_begin, 0);
+
+    // first chunk is indexed right away => the first page is shown immediately
+    this->indexNextChunk();
+
+    this->verticalScrollBar()->setValue(0);
+    this->horizontalScrollBar()->setValue(0);
+
+    return;
+}
+
+// [slot]
+void JsonViewer::indexNextChunk() {
+
+    const qint64 limit = qMin(_indexPosition + chunkSize, _end);
+
+    if (_isJson)
+        this->indexJson(limit);
+    else
+        this->indexText(limit);
+
+    this->updateScrollBars();
+    this->viewport()->update();
+
+    if (_indexPosition < _end)
+        _indexTimer->start();
+
+    return;
+}
+
+void JsonViewer::indexJson(const qint64 limit) {
+
+    // line breaks are placed the same way as by QJsonDocument::Indented:
+    // after opening bracket, after comma and before closing bracket (empty containers stay on one line)
+    const char * const data = _data.constData();
+
+    for (qint64 position = _indexPosition; position < limit; ++position) {
+
+        const char c = data[position];
+
+        if (_inString) {
+
+            if (_escape)
+                _escape = false;
+            else if (c == '\\')
+                _escape = true;
+            else if (c == '"')
+                _inString = false;
+            continue;
+        }
+
+        if (isWhitespace(c))
+            continue;
+
+        if (c == '}' || c == ']') {
+
+            --_depth;
+            if (!_afterOpen)
+                this->addLine(position, qMax(0, _depth));
+            _pendingBreak = false;
+            _afterOpen = false;
+            continue;
+        }
+
+        if (_pendingBreak) {
+
+            this->addLine(position, qMax(0, _depth));
+            _pendingBreak = false;
+        }
+        _afterOpen = false;
+
+        if (c == '"')
+            _inString = true;
+        else if (c == '{' || c == '[') {
+
+            ++_depth;
+            _pendingBreak = true;
+            _afterOpen = true;
+        }
+        else if (c == ',')
+            _pendingBreak = true;
+    }
+
+    _indexPosition = limit;
+    return;
+}
+
+void JsonViewer::indexText(const qint64 limit) {
+
+    const char * const data = _data.constData();
+    qint64 position = _indexPosition;
+
+    while (position < limit) {
+
+        const char * const newLine =
+            static_cast<const char *>(memchr(data + position, '\n', limit - position));
+        if (newLine == nullptr)
+            break;
+
+        position = (newLine - data) + 1;
+        if (position < _end)
+            this->addLine(position, 0);
+    }
+
+    _indexPosition = limit;
+    return;
+}
+
+QString JsonViewer::line(const int index) const {
+
+    if (index < 0 || index >= _lineOffsets.size())
+        return QString();
+
+    const char * const data = _data.constData();
+    const qint64 from = _lineOffsets.at(index);
+    const qint64 to = this->lineEnd(index);
+
+    QByteArray text;
+
+    if (!_isJson) {
+
+        qint64 length = qMin(to - from, static_cast<qint64>(maxLineLength));
+        while (length > 0 && (data[from + length - 1] == '\n' || data[from + length - 1] == '\r'))
+            --length;
+
+        text = QByteArray(data + from, static_cast<int>(length));
+        text.replace('\t', QByteArray(indentation, ' '));
+        return QString::fromUtf8(text);
+    }
+
+    // whitespace outside of strings is dropped, key is separated from value by ": "
+    text.reserve(static_cast<int>(qMin(to - from, static_cast<qint64>(maxLineLength))) +
+                 _lineDepths.at(index) * indentation);
+    text.fill(' ', _lineDepths.at(index) * indentation);
+
+    bool inString = false;
+    bool escape = false;
+
+    for (qint64 position = from; position < to && text.size() < maxLineLength; ++position) {
+
+        const char c = data[position];
+
+        if (inString) {
+
+            text += c;
+            if (escape)
+                escape = false;
+            else if (c == '\\')
+                escape = true;
+            else if (c == '"')
+                inString = false;
+            continue;
+        }
+
+        if (isWhitespace(c))
+            continue;
+
+        text += c;
+        if (c == '"')
+            inString = true;
+        else if (c == ':')
+            text += ' ';
+    }
+
+    return QString::fromUtf8(text);
+}
+
+int JsonViewer::drawLine(QPainter & painter, const QString & text, const int left, const int top) const {
+
+    const static QColor tokenColours[] = { QColor(Qt::black), QColor(0, 0, 139), QColor(0, 100, 0),
+                                           QColor(139, 0, 0), QColor(128, 0, 128) };
+
+    const QFontMetrics metrics = painter.fontMetrics();
+    const int baseline = top + metrics.ascent();
+
+    if (!_isJson) {
+
+        painter.setPen(tokenColours[PUNCTUATION]);
+        painter.drawText(left, baseline, text);
+        return metrics.horizontalAdvance(text);
+    }
+
+    int x = left;
+    int i = 0;
+
+    while (i < text.size()) {
+
+        const QChar c = text.at(i);
+        int j = i + 1;
+        TokenType type = PUNCTUATION;
+
+        if (c == QLatin1Char('"')) {
+
+            bool escape = false;
+            while (j < text.size()) {
+
+                const QChar d = text.at(j++);
+                if (escape)
+                    escape = false;
+                else if (d == QLatin1Char('\\'))
+                    escape = true;
+                else if (d == QLatin1Char('"'))
+                    break;
+            }
+            type = (j < text.size() && text.at(j) == QLatin1Char(':')) ? KEY : STRING;
+        }
+        else if (c == QLatin1Char('-') || c.isDigit()) {
+
+            while (j < text.size() && (text.at(j).isDigit() ||
+                   QStringLiteral(".eE+-").contains(text.at(j))))
+                ++j;
+            type = NUMBER;
+        }
+        else if (c.isLetter()) {
+
+            while (j < text.size() && text.at(j).isLetter())
+                ++j;
+            type = LITERAL;
+        }
+        else {
+
+            while (j < text.size() && text.at(j) != QLatin1Char('"') &&
+                   text.at(j) != QLatin1Char('-') && !text.at(j).isLetterOrNumber())
+                ++j;
+        }
+
+        const QString token = text.mid(i, j - i);
+        painter.setPen(tokenColours[type]);
+        painter.drawText(x, baseline, token);
+        x += metrics.horizontalAdvance(token);
+        i = j;
+    }
+
+    return (x - left);
+}
+
+void JsonViewer::updateScrollBars() {
+
+    const int visibleLines = qMax(1, this->viewport()->height() / _lineHeight);
+
+    this->verticalScrollBar()->setRange(0, qMax(0, this->lineCount() - visibleLines));
+    this->verticalScrollBar()->setPageStep(visibleLines);
+    this->verticalScrollBar()->setSingleStep(1);
+
+    this->horizontalScrollBar()->setRange(
+        0, qMax(0, _maxLineWidth + 2 * margin - this->viewport()->width()));
+    this->horizontalScrollBar()->setPageStep(this->viewport()->width());
+    this->horizontalScrollBar()->setSingleStep(this->fontMetrics().averageCharWidth());
+
+    return;
+}
+
+void JsonViewer::paintEvent(QPaintEvent *) {
+
+    QPainter painter(this->viewport());
+    painter.setFont(this->font());
+
+    if (this->lineCount() == 0) {
+
+        painter.setPen(this->palette().color(QPalette::Disabled, QPalette::Text));
+        painter.drawText(margin, margin + painter.fontMetrics().ascent(), QStringLiteral("prázdné"));
+        return;
+    }
+
+    // only visible lines are formatted
+    const int firstLine = this->verticalScrollBar()->value();
+    const int visibleLines = this->viewport()->height() / _lineHeight + 1;
+    const int left = margin - this->horizontalScrollBar()->value();
+
+    int maxLineWidth = _maxLineWidth;
+    for (int i = 0; i < visibleLines && firstLine + i < this->lineCount(); ++i) {
+
+        const int width = drawLine(painter, this->line(firstLine + i), left, i * _lineHeight);
+        maxLineWidth = qMax(maxLineWidth, width);
+    }
+
+    // width of the widest line seen so far determines horizontal range
+    if (maxLineWidth > _maxLineWidth) {
+
+        _maxLineWidth = maxLineWidth;
+        this->updateScrollBars();
+    }
+    return;
+}
+
+void JsonViewer::resizeEvent(QResizeEvent * event) {
+
+    QAbstractScrollArea::resizeEvent(event);
+    this->updateScrollBars();
+
+    return;
+}
+
+void JsonViewer::keyPressEvent(QKeyEvent * event) {
+
+    if (event->matches(QKeySequence::Copy)) {
+
+        const QByteArray contents = QByteArray::fromRawData(
+            _data.constData() + _begin, static_cast<int>(_end - _begin));
+        QApplication::clipboard()->setText(QString::fromUtf8(contents));
+        return;
+    }
+
+    if (event->matches(QKeySequence::MoveToStartOfDocument)) {
+
+        this->verticalScrollBar()->triggerAction(QAbstractSlider::SliderToMinimum);
+        return;
+    }
+
+    if (event->matches(QKeySequence::MoveToEndOfDocument)) {
+
+        this->verticalScrollBar()->triggerAction(QAbstractSlider::SliderToMaximum);
+        return;
+    }
+
+    QAbstractScrollArea::keyPressEvent(event);
+    return;
+}
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef JSONVIEWER_H
+#define JSONVIEWER_H
+
+#include <QAbstractScrollArea>
+#include <QByteArray>
+#include <QPainter>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+// read-only viewer of (very large) response bodies; raw bytes are indexed (start
+// of every pretty-printed line) and only visible lines are formatted and highlighted
+class JsonViewer: public QAbstractScrollArea {
+
+    Q_OBJECT
+
+    public:
+        explicit JsonViewer(QWidget * = nullptr);
+        ~JsonViewer() {}
+
+        // bodies larger than threshold are not passed to QTextEdit (see ResponseWindow)
+        const static int sizeThreshold;
+        const static int indentation;
+        const static int maxLineLength;
+
+        void setContents(const QByteArray &, const qint64 = 0, const qint64 = -1);
+        inline int lineCount() const { return _lineOffsets.size(); }
+        QString line(const int) const;
+
+    protected:
+        void paintEvent(QPaintEvent *) override;
+        void resizeEvent(QResizeEvent *) override;
+        void keyPressEvent(QKeyEvent *) override;
+
+    private:
+        enum TokenType { PUNCTUATION = 0, KEY = 1, STRING = 2, NUMBER = 3, LITERAL = 4 };
+
+        inline static bool isWhitespace(const char c)
+            { return (c == ' ' || c == '\n' || c == '\r' || c == '\t'); }
+        inline qint64 lineEnd(const int index) const
+            { return (index + 1 < _lineOffsets.size()) ? _lineOffsets.at(index + 1) : _indexPosition; }
+        inline void addLine(const qint64 offset, const int depth)
+            { _lineOffsets.push_back(offset); _lineDepths.push_back(static_cast<quint16>(depth)); return; }
+
+        void indexJson(const qint64);
+        void indexText(const qint64);
+        void updateScrollBars();
+        int drawLine(QPainter &, const QString &, const int, const int) const;
+
+        QByteArray _data;
+        qint64 _begin;
+        qint64 _end;
+        bool _isJson;
+
+        // start of every line (offset into _data) and its indentation level
+        QVector<qint64> _lineOffsets;
+        QVector<quint16> _lineDepths;
+
+        // state of (chunked) indexing
+        QTimer * _indexTimer;
+        qint64 _indexPosition;
+        int _depth;
+        bool _inString;
+        bool _escape;
+        bool _pendingBreak;
+        bool _afterOpen;
+
+        int _lineHeight;
+        int _maxLineWidth;
+
+    private slots:
+        void indexNextChunk();
+};
+
+#endif // JSONVIEWER_H
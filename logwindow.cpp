@@ -3,25 +3,55 @@
  This program is distributed under the terms of the GNU General Public License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QProgressDialog>
+#include "diffwindow.h"
+#include "harreader.h"
+#include "harwriter.h"
+#include "jsondiff.h"
 #include "logwindow.h"
 #include "requestwindow.h"
+#include "timingstatistics.h"
 
-LogWindow::LogWindow(const QVector<Communication> & comm, QWidget * parent):
-    QDialog(parent), _communication(comm), ui(new Ui_LogWindow) {
+const int LogWindow::maxSearchResults = 10000;
 
-    ui->setupUi(this, _communication);
+LogWindow::LogWindow(Session * const session, QWidget * parent):
+    QDialog(parent), _communicationModel(new CommunicationModel(session, this)),
+    _journal(session->journal()), _journalModel(new JournalModel(_journal, this)), ui(new Ui_LogWindow) {
+
+    ui->setupUi(this, _communicationModel, _journalModel);
 
     connect(ui->displayRequestButton, &QPushButton::clicked,
             this, &LogWindow::displayRequestWindow);
+    connect(ui->queryButton, &QPushButton::clicked, this, &LogWindow::evaluateQuery);
+    connect(ui->queryLineEdit, &QLineEdit::returnPressed, this, &LogWindow::evaluateQuery);
+    connect(ui->listOfCommunicationTable->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &LogWindow::enableButtons);
+    connect(_communicationModel, &CommunicationModel::rowsInserted, this, &LogWindow::updateRowCount);
+    // completed messages are appended to journal as well (see Session::setReplyToCurrentRequest)
+    connect(session, &Session::messageChanged, _journalModel, &JournalModel::refresh);
+    connect(ui->compareButton, &QPushButton::clicked, this, &LogWindow::displayDiffWindow);
+    connect(ui->exportTimingButton, &QPushButton::clicked, this, &LogWindow::exportTimings);
+    connect(ui->exportHarButton, &QPushButton::clicked, this, &LogWindow::exportHar);
+    connect(ui->importHarButton, &QPushButton::clicked, this, &LogWindow::importHar);
+    connect(ui->searchButton, &QPushButton::clicked, this, &LogWindow::searchJournal);
+    connect(ui->searchLineEdit, &QLineEdit::returnPressed, this, &LogWindow::searchJournal);
+    connect(ui->journalTableView->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, &LogWindow::displayJournalBody);
     connect(ui->closeButton, &QPushButton::clicked, this, &LogWindow::close);
 }
 
 // [slot]
 int LogWindow::displayRequestWindow() {
 
-    const int row = ui->listOfCommunicationTable->currentRow();
+    const int row = ui->listOfCommunicationTable->currentIndex().row();
+    if (row < 0)
+        return QDialog::Rejected;
 
-    RequestWindow requestWindow(_communication.at(row).request(), _communication.at(row).ID(), this);
+    const Communication & comm = _communicationModel->communication(row);
+    RequestWindow requestWindow(comm.request(), comm.ID(), this);
     return requestWindow.exec();
 }
 
@@ -30,3 +60,230 @@ int LogWindow::displayResponseWindow() {
 
     return 0;
 }
+
+// [slot]
+void LogWindow::evaluateQuery() {
+
+    const QString expression = ui->queryLineEdit->text().trimmed();
+
+    if (expression.isEmpty()) {
+
+        _query = JsonQuery();
+        _communicationModel->setQuery(_query);
+        ui->listOfCommunicationTable->setColumnHidden(CommunicationModel::QUERY_RESULT, true);
+        return;
+    }
+
+    if (expression != _query.expression())
+        _query = JsonQuery(expression);
+
+    if (!_query.isValid()) {
+
+        QMessageBox::warning(this, QStringLiteral("Chybný dotaz"), _query.error());
+        return;
+    }
+
+    // the same compiled query for every response (evaluated as rows become visible)
+    _communicationModel->setQuery(_query);
+    ui->listOfCommunicationTable->setColumnHidden(CommunicationModel::QUERY_RESULT, false);
+    return;
+}
+
+// [slot]
+void LogWindow::enableButtons() {
+
+    const int selectedRows = ui->listOfCommunicationTable->selectionModel()->selectedRows().size();
+
+    ui->displayRequestButton->setEnabled(selectedRows != 0);
+    ui->compareButton->setEnabled(selectedRows == 2);
+    return;
+}
+
+// [slot]
+void LogWindow::updateRowCount() {
+
+    this->setWindowTitle(QStringLiteral("Historie komunikace (celkem záznamů: ") +
+                         QString::number(_communicationModel->rowCount()) + QStringLiteral(")"));
+    return;
+}
+
+// [slot]
+int LogWindow::displayDiffWindow() {
+
+    QModelIndexList selectedRows = ui->listOfCommunicationTable->selectionModel()->selectedRows();
+    if (selectedRows.size() != 2)
+        return QDialog::Rejected;
+
+    // older response is compared to newer one
+    std::sort(selectedRows.begin(), selectedRows.end());
+    const Communication & before = _communicationModel->communication(selectedRows.first().row());
+    const Communication & after = _communicationModel->communication(selectedRows.last().row());
+
+    const JsonDiff diff(before.response().jsonRoot(), after.response().jsonRoot());
+
+    const auto title = [](const Communication & comm) {
+        return QString::number(comm.ID()) + QStringLiteral(": ") +
+               comm.request().request().url().toDisplayString(); };
+
+    DiffWindow diffWindow(diff, title(before), title(after), this);
+    return diffWindow.exec();
+}
+
+// [slot]
+void LogWindow::exportTimings() {
+
+    const QString fileName = QFileDialog::getSaveFileName(this, QStringLiteral("Export časů"), QString(),
+                                                          QStringLiteral("CSV (*.csv)"));
+    if (fileName.isEmpty())
+        return;
+
+    // rows of current tab (journal may be limited by search)
+    TimingStatistics statistics;
+    if (ui->historyTabWidget->currentWidget() == ui->journalTab)
+        for (int row = 0; row < _journalModel->rowCount(); ++row) {
+
+            const JournalEntry * const entry = _journalModel->entry(row);
+            if (entry != nullptr)
+                statistics.add(entry->httpMethod, entry->url, entry->timing);
+        }
+    else
+        for (int row = 0; row < _communicationModel->rowCount(); ++row) {
+
+            const Communication & comm = _communicationModel->communication(row);
+            statistics.add(comm.request().httpMethod(), comm.request().request().url(), comm.timing());
+        }
+
+    if (!statistics.exportToCsv(fileName))
+        QMessageBox::warning(this, QStringLiteral("Export časů"),
+                             QStringLiteral("Soubor ") + fileName + QStringLiteral(" nelze uložit."));
+    return;
+}
+
+// [slot]
+void LogWindow::exportHar() {
+
+    const QString fileName = QFileDialog::getSaveFileName(this, QStringLiteral("Export HAR"), QString(),
+                                                          QStringLiteral("HAR (*.har)"));
+    if (fileName.isEmpty())
+        return;
+
+    // rows of current tab are written one by one (bodies of journal entries are read on the way)
+    const bool journalRows = (ui->historyTabWidget->currentWidget() == ui->journalTab);
+    const int rowCount = (journalRows) ? _journalModel->rowCount() : _communicationModel->rowCount();
+
+    HarWriter writer(fileName);
+    QProgressDialog progress(QStringLiteral("Export do souboru HAR"), QStringLiteral("Zrušit"), 0, rowCount, this);
+    progress.setWindowModality(Qt::WindowModal);
+
+    for (int row = 0; row < rowCount && writer.isOpen() && !progress.wasCanceled(); ++row) {
+
+        progress.setValue(row);
+
+        if (journalRows) {
+
+            // journal may contain token messages stored before they were excluded
+            const JournalEntry * const entry = _journalModel->entry(row);
+            if (entry != nullptr && Journal::isStorable(*entry))
+                writer.write(*entry, _journal->body(entry->requestBodyOffset, entry->requestBodyLength),
+                             _journal->body(entry->responseBodyOffset, entry->responseBodyLength));
+        }
+        else {
+
+            const Communication & comm = _communicationModel->communication(row);
+            const JournalEntry entry = Journal::toEntry(comm);
+            if (Journal::isStorable(entry))
+                writer.write(entry, comm.request().body(), comm.response().response());
+        }
+    }
+    progress.setValue(rowCount);
+
+    if (!writer.finish())
+        QMessageBox::warning(this, QStringLiteral("Export HAR"),
+                             QStringLiteral("Soubor ") + fileName + QStringLiteral(" nelze uložit."));
+    return;
+}
+
+// [slot]
+void LogWindow::importHar() {
+
+    const QString fileName = QFileDialog::getOpenFileName(this, QStringLiteral("Import HAR"), QString(),
+                                                          QStringLiteral("HAR (*.har);;JSON (*.json)"));
+    if (fileName.isEmpty())
+        return;
+
+    HarReader reader(fileName);
+    if (!reader.isOpen()) {
+
+        QMessageBox::warning(this, QStringLiteral("Import HAR"),
+                             QStringLiteral("Soubor ") + fileName + QStringLiteral(" nelze otevřít."));
+        return;
+    }
+
+    // entries are stored in journal as they are read => they can be replayed and searched
+    QProgressDialog progress(QStringLiteral("Import ze souboru HAR"), QStringLiteral("Zrušit"), 0, 1000, this);
+    progress.setWindowModality(Qt::WindowModal);
+
+    JournalEntry entry;
+    QByteArray requestBody;
+    QByteArray responseBody;
+    int imported = 0;
+    int skipped = 0;
+
+    while (!progress.wasCanceled() && reader.next(entry, requestBody, responseBody)) {
+
+        if (!Journal::isStorable(entry))
+            ++skipped;
+        else if (_journal->append(entry, requestBody, responseBody))
+            ++imported;
+        progress.setValue(reader.progress());
+    }
+    progress.setValue(1000);
+
+    _journalModel->refresh();
+    ui->historyTabWidget->setCurrentWidget(ui->journalTab);
+
+    QString result = QStringLiteral("Importováno záznamů: ") + QString::number(imported);
+    if (skipped > 0)
+        result += QStringLiteral(", vynecháno tokenů: ") + QString::number(skipped);
+    if (reader.hasError())
+        QMessageBox::warning(this, QStringLiteral("Import HAR"),
+                             result + QStringLiteral(" (zbytek souboru nelze přečíst)."));
+    else
+        QMessageBox::information(this, QStringLiteral("Import HAR"), result);
+    return;
+}
+
+// [slot]
+void LogWindow::searchJournal() {
+
+    const QString text = ui->searchLineEdit->text().trimmed();
+
+    if (text.isEmpty()) {
+
+        _journalModel->clearFilter();
+        ui->searchResultLabel->clear();
+        return;
+    }
+
+    if (text.toUtf8().size() < TrigramIndex::minQueryLength) {
+
+        ui->searchResultLabel->setText(QStringLiteral("příliš krátký text"));
+        return;
+    }
+
+    // newest entries are shown if there are more hits
+    const QVector<qint64> entries = _journal->search(text, maxSearchResults);
+    _journalModel->setFilter(entries);
+    ui->journalBodyViewer->setContents(QByteArray());
+    ui->searchResultLabel->setText(QStringLiteral("nalezeno: ") + QString::number(entries.size()) +
+        ((entries.size() == maxSearchResults) ? QStringLiteral(" (nejnovější)") : QString()));
+    return;
+}
+
+// [slot]
+void LogWindow::displayJournalBody(const QModelIndex & current) {
+
+    // body is read from journal only when entry is selected
+    ui->journalBodyViewer->setContents(_journalModel->responseBody(current.row()));
+    return;
+}
@@ -7,6 +7,9 @@
 #define LOGWINDOW_H
 
 #include <QWidget>
+#include "communicationmodel.h"
+#include "journalmodel.h"
+#include "session.h"
 #include "ui/ui_logwindow.h"
 
 class LogWindow: public QDialog {
@@ -14,16 +17,30 @@ class LogWindow: public QDialog {
     Q_OBJECT
 
     public:
-        explicit LogWindow(const QVector<Communication> &, QWidget * = nullptr);
+        const static int maxSearchResults;
+
+        explicit LogWindow(Session * const, QWidget * = nullptr);
         ~LogWindow() { delete ui; }
 
     private:
-        const QVector<Communication> & _communication;
+        CommunicationModel * _communicationModel;
+        JsonQuery _query; // compiled on change of expression only
+        Journal * const _journal;
+        JournalModel * _journalModel;
         Ui_LogWindow * ui;
 
     private slots:
         int displayRequestWindow();
         int displayResponseWindow();
+        void evaluateQuery();
+        void enableButtons();
+        void updateRowCount();
+        int displayDiffWindow();
+        void exportTimings();
+        void exportHar();
+        void importHar();
+        void searchJournal();
+        void displayJournalBody(const QModelIndex &);
 };
 
 #endif // LOGWINDOW_H
@@ -15,15 +15,25 @@
 #include "logwindow.h"
 #include "mainwindow.h"
 #include "methods.h"
+#include "replaywindow.h"
 #include "responsewindow.h"
 #include "tokenwindow.h"
 #include "ui/ui_mainwindow.h"
 
 MainWindow::MainWindow(QWidget * parent): QDialog(parent), ui(new Ui_MainWindow),
-    _delaySwaggerProcessing(false), _currentSession(new Session) {
+    _delaySwaggerProcessing(false), _currentSession(new Session), _swaggerProgressDialog(nullptr) {
 
     ui->setupUi(this);
 
+    connect(_currentSession, &Session::swaggerLoadingStarted,
+            this, &MainWindow::showSwaggerProgress);
+    connect(_currentSession, &Session::swaggerLoadingFinished,
+            this, &MainWindow::finishSwaggerProcessing);
+    connect(_currentSession, &Session::swaggerVersionLoaded,
+            this, &MainWindow::addSwaggerVersion);
+    connect(ui->swaggerVersionComboBox, static_cast<void(QComboBox::*)(int)>
+            (&QComboBox::activated), this, &MainWindow::selectSwaggerVersion);
+
     connect(ui->selectConfigFileButton, &QPushButton::clicked,
             this, &MainWindow::selectConfigFile);
     connect(ui->selectConfigFileLineEdit, &QLineEdit::editingFinished,
@@ -129,6 +139,8 @@ MainWindow::MainWindow(QWidget * parent): QDialog(parent), ui(new Ui_MainWindow)
             this, &MainWindow::processReceivedReply);
     connect(this, &MainWindow::processingOfGeneralRequestFinished,
             this, &MainWindow::displayResponseWindow);
+    connect(this->_currentSession, &Session::allPagesFetched,
+            this, &MainWindow::finishPagedRequest);
 
     connect(ui->useProxyCheckBox, &QCheckBox::stateChanged, this, [this]() -> void
             { _currentSession->setAndApplyProxy(ui->useProxyCheckBox->isChecked()); } );
@@ -140,6 +152,8 @@ MainWindow::MainWindow(QWidget * parent): QDialog(parent), ui(new Ui_MainWindow)
             this, &MainWindow::enableGetEndpointsButton);
     connect(ui->logButton, &QPushButton::clicked,
             this, &MainWindow::displayLogWindow);
+    connect(ui->replayButton, &QPushButton::clicked,
+            this, &MainWindow::displayReplayWindow);
 
     connect(ui->generateTokenButton, &QPushButton::clicked, this, &MainWindow::generateToken);
     connect(ui->connectToServerButton, &QPushButton::clicked, this, &MainWindow::loadClientParams);
@@ -443,26 +457,66 @@ void MainWindow::processSwaggerFile() const {
 
     this->_currentSession->setFileName(ui->swaggerFileLocationLineEdit->text());
 
-    err::fileError error = this->_currentSession->openFile(_currentSession);
+    const err::fileError error = this->_currentSession->openFile(_currentSession);
     if (static_cast<int>(error)) {
 
         const QString text = QStringLiteral("Chyba čtení souboru.");
         showFileErrorBox(this->_currentSession->fileName(), text, error);
+        ui->changeSwaggerLocationButton->setEnabled(true);
         return;
     }
-    else {
 
-        const bool fileParsed = this->_currentSession->parseSwaggerFile();
-        if (!fileParsed) {
+    // result is processed in finishSwaggerProcessing()
+    if (!(this->_currentSession->loadSwaggerFile()))
+        finishSwaggerProcessing(false, false);
+
+    return;
+}
+
+// [slot]
+void MainWindow::showSwaggerProgress() {
+
+    // dialog is created on demand (QProgressDialog shows itself after minimumDuration)
+    if (_swaggerProgressDialog == nullptr) {
+
+        _swaggerProgressDialog = new QProgressDialog(
+            QStringLiteral("Zpracování Swagger dokumentace..."), QStringLiteral("Zrušit"), 0, 100, this);
+        _swaggerProgressDialog->setWindowTitle(QStringLiteral("Swagger"));
+        _swaggerProgressDialog->setMinimumDuration(500);
+
+        connect(_swaggerProgressDialog, &QProgressDialog::canceled,
+                this, [this]() -> void { this->_currentSession->cancelSwaggerLoading(); } );
+        connect(_currentSession, &Session::swaggerLoadingProgress,
+                _swaggerProgressDialog, &QProgressDialog::setValue);
+    }
+
+    ui->changeSwaggerLocationButton->setEnabled(false);
+    _swaggerProgressDialog->setValue(0);
+
+    return;
+}
+
+// [slot]
+void MainWindow::finishSwaggerProcessing(const bool loaded, const bool cancelled) const {
+
+    if (_swaggerProgressDialog != nullptr)
+        _swaggerProgressDialog->reset();
+
+    // cancelled by user => no error is reported
+    if (!loaded && !cancelled) {
+
+        // Swagger has been loaded from file
+        if (ui->swaggerWebLocationLineEdit->isHidden()) {
 
             const QString text = QStringLiteral("Chyba při zpracování souboru.");
-            error = err::NOT_PARSED;
             const QString detailText =
                 QStringLiteral("Nepodařilo se správně zpracovat soubor se Swagger dokumentací. "
                                "Z tohoto důvodu nebude pravděpodobně možné použít metody API "
                                "se vstupními parametry.");
-            showFileErrorBox(this->_currentSession->fileName(), text, error, detailText);
+            showFileErrorBox(this->_currentSession->fileName(), text, err::NOT_PARSED, detailText);
         }
+        else
+            showSwaggerErrorBox(err::FILE_NOT_PARSED);
     }
 
     ui->changeSwaggerLocationButton->setEnabled(true);
@@ -573,7 +627,7 @@ void MainWindow::generateToken() const {
     return;
 }
 
-void MainWindow::processTokenReply(const StatusCode & status, uint16_t ID) const {
+void MainWindow::processTokenReply(const StatusCode & status, quint64 ID) const {
 
     if (status == OK || _currentSession->inTestMode()) {
 
@@ -615,6 +669,10 @@ void MainWindow::changeSwaggerLocation() const {
     ui->swaggerFromWebButton->setVisible(ui->swaggerFromWebButton->isHidden());
     ui->swaggerFromFileButton->setVisible(ui->swaggerFromFileButton->isHidden());
 
+    // versions are available only for web source
+    ui->swaggerVersionComboBox->setVisible(!(ui->swaggerWebLocationLineEdit->isHidden()) &&
+                                           ui->swaggerVersionComboBox->count() > 1);
+
     return;
 }
 
@@ -635,7 +693,7 @@ void MainWindow::getEndpoints() const {
     return;
 }
 
-void MainWindow::processEndpointsReply(const StatusCode & status, uint16_t ID) const {
+void MainWindow::processEndpointsReply(const StatusCode & status, quint64 ID) const {
 
     if (status == OK || _currentSession->inTestMode()) {
 
@@ -649,7 +707,7 @@ void MainWindow::processEndpointsReply(const StatusCode & status, uint16_t ID) c
 /* section: swagger */
 
 // [slot]
-void MainWindow::processSwaggerDocsReply(const StatusCode & status, uint16_t ID) const {
+void MainWindow::processSwaggerDocsReply(const StatusCode & status, quint64 ID) const {
 
     err::swaggerError error = err::SWAGGER_OK;
 
@@ -666,13 +724,14 @@ void MainWindow::processSwaggerDocsReply(const StatusCode & status, uint16_t ID)
 
         if (error == err::SWAGGER_OK) {
 
+            ui->swaggerVersionComboBox->clear();
+            ui->swaggerVersionComboBox->setHidden(true);
+
+            // all versions are downloaded at once (see processSwaggerVersionReply())
             // do not change conditions' sequence (left-to-right)
             if (_currentSession->inTestMode() ||
-                !(_currentSession->downloadSwaggerFromWeb(swaggerDocs)))
+                !(_currentSession->downloadSwaggerVersions(swaggerDocs)))
                 error = err::FILE_NOT_DOWNLOADED;
-
-            if (error == err::SWAGGER_OK && !(_currentSession->parseSwaggerFile()))
-                error = err::FILE_NOT_PARSED;
         }
     }
     else
@@ -684,6 +743,48 @@ void MainWindow::processSwaggerDocsReply(const StatusCode & status, uint16_t ID)
     return;
 }
 
+// [private member function]
+void MainWindow::processSwaggerVersionReply(quint64 ID) const {
+
+    // parsing continues on worker thread (see finishSwaggerProcessing())
+    QString version;
+    const bool downloaded = this->_currentSession->parseSwaggerVersionReply(ID, version);
+
+    // failure of other than selected version is not reported (it is only not offered)
+    if (!downloaded && !version.isEmpty() && version == _currentSession->currentSwaggerVersion())
+        showSwaggerErrorBox(err::FILE_NOT_DOWNLOADED);
+
+    return;
+}
+
+// [slot]
+void MainWindow::addSwaggerVersion(const QString & version) const {
+
+    if (ui->swaggerVersionComboBox->findText(version) == -1) {
+
+        // versions are listed in alphabetical order (v1.0, v2.0, ...)
+        const QStringList versions = _currentSession->swaggerVersions();
+        ui->swaggerVersionComboBox->clear();
+        ui->swaggerVersionComboBox->addItems(versions);
+    }
+
+    ui->swaggerVersionComboBox->setCurrentText(_currentSession->currentSwaggerVersion());
+    ui->swaggerVersionComboBox->setVisible(!(ui->swaggerWebLocationLineEdit->isHidden()) &&
+                                           ui->swaggerVersionComboBox->count() > 1);
+    return;
+}
+
+// [slot]
+void MainWindow::selectSwaggerVersion() const {
+
+    // already parsed version is switched without downloading
+    const QString version = ui->swaggerVersionComboBox->currentText();
+    if (version != _currentSession->currentSwaggerVersion())
+        this->_currentSession->selectSwaggerVersion(version);
+
+    return;
+}
+
 /* section: general request */
 
 // [slot]
@@ -705,8 +806,8 @@ void MainWindow::sendRequest() const {
         const QPair<bool, QString> ownSelectClause =
             { ui->useOwnSelectConditionCheckBox->isChecked(), ui->selectConditionLineEdit->text()};
 
-        const bool requestPrepared =
-            this->_currentSession->prepareGeneralGetRequest(path, accept, http::GET, ownSelectClause);
+        const bool requestPrepared = this->_currentSession->prepareGeneralGetRequest(
+            path, accept, http::GET, ownSelectClause, ui->allPagesCheckBox->isChecked());
         if (requestPrepared)
             this->_currentSession->sendGetRequestAndWaitForReply();
     }
@@ -734,7 +835,7 @@ void MainWindow::sendRequest() const {
     return;
 }
 
-void MainWindow::processGeneralRequestReply(const StatusCode & status, uint16_t ID,
+void MainWindow::processGeneralRequestReply(const StatusCode & status, quint64 ID,
     const QNetworkAccessManager::Operation httpMethod) const {
 
     if (status == OK || _currentSession->inTestMode()) {
@@ -755,7 +856,7 @@ void MainWindow::processReceivedReply(const QNetworkReply * const reply) const {
 
     const RequestType requestType =
         static_cast<RequestType>(originalRequest.attribute(QNetworkRequest::User).toInt());
-    const uint16_t ID = originalRequest.attribute(Request::userAttribute(1)).toInt();
+    const quint64 ID = originalRequest.attribute(Request::userAttribute(1)).toULongLong();
     const QNetworkAccessManager::Operation httpMethod = reply->operation();
 
     switch (requestType) {
@@ -785,12 +886,43 @@ void MainWindow::processReceivedReply(const QNetworkReply * const reply) const {
         }
         case OTHER: {
             processGeneralRequestReply(_currentSession->getStatus(reply), ID, httpMethod);
-            emit processingOfGeneralRequestFinished(reply);
+            // response is shown after remaining pages (if any) have been fetched and merged
+            if (!_currentSession->fetchRemainingPages(ID))
+                emit processingOfGeneralRequestFinished(reply);
+            break;
+        }
+        case SWAGGER_DOC: {
+            processSwaggerVersionReply(ID);
+            break;
+        }
+        case PAGE: {
+            _currentSession->parsePageReply(ID);
         }
     }
     return;
 }
 
+// [slot]
+void MainWindow::finishPagedRequest(const QNetworkReply * const reply, const bool complete) const {
+
+    if (!complete) {
+
+        QMessageBox * messageBox = new QMessageBox;
+        messageBox->setWindowTitle(QStringLiteral("Stránkování"));
+        messageBox->setText(QStringLiteral("Některé stránky se nepodařilo načíst."));
+        messageBox->setInformativeText(QStringLiteral("Zobrazena je pouze první stránka odpovědi "
+                                                      "(ostatní jsou k dispozici v logu)."));
+        messageBox->setIcon(QMessageBox::Warning);
+        messageBox->setStandardButtons(QMessageBox::Ok);
+        messageBox->exec();
+
+        delete messageBox;
+    }
+
+    emit processingOfGeneralRequestFinished(reply);
+    return;
+}
+
 /* section: windows */
 
 // [slot]
@@ -817,6 +949,13 @@ int MainWindow::displayResponseWindow(const QNetworkReply * const reply) {
 // [slot]
 int MainWindow::displayLogWindow() {
 
-    LogWindow logWindow(this->_currentSession->communication(), this);
+    LogWindow logWindow(this->_currentSession, this);
     return logWindow.exec();
 }
+
+// [slot]
+int MainWindow::displayReplayWindow() {
+
+    ReplayWindow replayWindow(this->_currentSession, this);
+    return replayWindow.exec();
+}
@@ -6,6 +6,7 @@
 #ifndef MAINWINDOW_H
 #define MAINWINDOW_H
 
+#include <QProgressDialog>
 #include <QSqlError>
 #include "session.h"
 #include "ui/ui_mainwindow.h"
@@ -33,16 +34,18 @@ class MainWindow: public QDialog {
         void processSwaggerWebSource() const;
         void cutText(QLineEdit * const, const int) const;
         void changeIconAccordingToTestConnectionResult(const StatusCode &) const;
-        void processTokenReply(const StatusCode &, uint16_t) const;
-        void processEndpointsReply(const StatusCode &, uint16_t) const;
-        void processSwaggerDocsReply(const StatusCode &, uint16_t) const;
-        void processGeneralRequestReply(const StatusCode &, uint16_t,
+        void processTokenReply(const StatusCode &, quint64) const;
+        void processEndpointsReply(const StatusCode &, quint64) const;
+        void processSwaggerDocsReply(const StatusCode &, quint64) const;
+        void processSwaggerVersionReply(quint64) const;
+        void processGeneralRequestReply(const StatusCode &, quint64,
                                         const QNetworkAccessManager::Operation) const;
         inline bool isOutputMethod(const QString & currentMethod) const
            { return (http::httpMethods[currentMethod]._dtoObjectType == http::OUTPUT); }
 
         bool _delaySwaggerProcessing;
         Session * _currentSession;
+        QProgressDialog * _swaggerProgressDialog;
 
     signals:
         void processingOfGeneralRequestFinished(const QNetworkReply * const) const;
@@ -65,6 +68,10 @@ class MainWindow: public QDialog {
         void changeSwaggerLocation() const;
         void selectSwaggerFile(const bool = false);
         void selectSwaggerWebSource(const bool = false);
+        void showSwaggerProgress();
+        void finishSwaggerProcessing(const bool, const bool) const;
+        void addSwaggerVersion(const QString &) const;
+        void selectSwaggerVersion() const;
 
         void hideSelectAndFilterWidget() const;
 
@@ -73,11 +80,13 @@ class MainWindow: public QDialog {
         void sendRequest() const;
 
         void processReceivedReply(const QNetworkReply * const) const;
+        void finishPagedRequest(const QNetworkReply * const, const bool) const;
 
         int displayTokenWindow();
         int displayEndpointsWindow();
         int displayResponseWindow(const QNetworkReply * const);
         int displayLogWindow();
+        int displayReplayWindow();
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,201 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <climits>
+#include "connection.h"
+#include "replayengine.h"
+
+ReplayEngine::ReplayEngine(Session * const session, QObject * parent):
+    QObject(parent), _session(session), _journal(session->journal()),
+    _networkManager(new QNetworkAccessManager(this)), _pacing(ORIGINAL), _scale(1.0),
+    _maxInFlight(1), _next(0), _last(-1), _running(false), _replayed(0), _statusChanges(0) {
+
+    // replies must not be processed by session (they are not part of its communication)
+    _networkManager->setProxy(session->_networkManager->proxy());
+    _timer.setSingleShot(true);
+
+    connect(_networkManager, &QNetworkAccessManager::finished, this, &ReplayEngine::replyFinished);
+    connect(&_timer, &QTimer::timeout, this, &ReplayEngine::sendNext);
+}
+
+ReplayEngine::~ReplayEngine() {
+
+    this->stop();
+}
+
+// entries first..last (incl.) of journal
+bool ReplayEngine::start(const qint64 first, const qint64 last, const Pacing pacing,
+                         const double scale, const int inFlight) {
+
+    if (_running || _journal == nullptr || first < 0 || last < first || last >= _journal->entryCount())
+        return false;
+
+    JournalEntry firstEntry;
+    if (!_journal->entry(first, firstEntry))
+        return false;
+
+    _pacing = pacing;
+    _scale = (pacing == SCALED && scale > 0.0) ? scale : 1.0;
+    _maxInFlight = qMax(1, inFlight);
+    _next = first;
+    _last = last;
+    _firstRecorded = firstEntry.createDate;
+    _replayed = 0;
+    _statusChanges = 0;
+    _running = true;
+    _clock.start();
+
+    this->sendNext();
+    return true;
+}
+
+void ReplayEngine::stop() {
+
+    _timer.stop();
+    _running = false;
+
+    // pending replies are dropped (finished() is emitted by abort)
+    const QList<QNetworkReply *> replies = _pending.keys();
+    for (auto it: replies)
+        it->abort();
+
+    return;
+}
+
+void ReplayEngine::finish() {
+
+    _running = false;
+    emit finished(_replayed, _statusChanges);
+
+    return;
+}
+
+// target server is the current one (scheme, host and port), path and query are kept
+bool ReplayEngine::buildRequest(const JournalEntry & entry, QNetworkRequest & request) const {
+
+    const QString hostNameInclPath = _session->apiServer()->hostName();
+    const QString host = (hostNameInclPath.contains('/')) ?
+        hostNameInclPath.left(hostNameInclPath.indexOf('/')) : hostNameInclPath;
+    if (host.isEmpty() || !entry.url.isValid())
+        return false;
+
+    QUrl url = entry.url;
+    url.setScheme(protocols.at(static_cast<int>(_session->apiServer()->protocol())));
+    url.setHost(host, QUrl::StrictMode);
+    url.setPort(_session->apiServer()->port());
+
+    request = QNetworkRequest(url);
+    for (const auto & it: entry.requestHeaders)
+        request.setRawHeader(it.first, it.second);
+
+    // token of current session (stored requests do not contain any)
+    if (!_session->token()->isNotComplete())
+        _session->setAuthorizationHeader(&request);
+
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+
+    return true;
+}
+
+bool ReplayEngine::send(const qint64 number, const JournalEntry & entry) {
+
+    QNetworkRequest request;
+    if (!this->buildRequest(entry, request))
+        return false;
+
+    const QByteArray body = _journal->body(entry.requestBodyOffset, entry.requestBodyLength);
+    QNetworkReply * reply = nullptr;
+
+    switch (entry.httpMethod) {
+
+        case http::GET: reply = _networkManager->get(request); break;
+        case http::POST: reply = _networkManager->post(request, body); break;
+        case http::PUT: reply = _networkManager->put(request, body); break;
+        case http::DELETE: reply = _networkManager->deleteResource(request); break;
+        default: return false;
+    }
+
+    const ReplayResult result =
+        { number, entry.ID, entry.httpMethod, request.url(), entry.statusCode, NO_REPLY, QString(),
+          entry.timing.total(), -1 };
+    _pending.insert(reply, qMakePair(result, _clock.elapsed()));
+
+    return true;
+}
+
+// [slot]
+void ReplayEngine::sendNext() {
+
+    while (_running) {
+
+        if (_next > _last) {
+
+            if (_pending.isEmpty())
+                this->finish();
+            return;
+        }
+
+        // closed loop: next request is sent when one of previous ones has finished
+        if (_pacing == AS_FAST_AS_POSSIBLE && _pending.size() >= _maxInFlight)
+            return;
+
+        JournalEntry entry;
+        if (!_journal->entry(_next, entry)) {
+
+            ++_next;
+            continue;
+        }
+
+        // open loop: request is sent at its (scaled) original time regardless of replies
+        if (_pacing != AS_FAST_AS_POSSIBLE) {
+
+            const qint64 due = static_cast<qint64>(_firstRecorded.msecsTo(entry.createDate) * _scale);
+            const qint64 elapsed = _clock.elapsed();
+            if (due > elapsed) {
+
+                _timer.start(static_cast<int>(qMin(due - elapsed, static_cast<qint64>(INT_MAX))));
+                return;
+            }
+        }
+
+        ++_next;
+
+        // token requests are not replayed (current token is used instead)
+        if (entry.requestType == TOKEN)
+            continue;
+
+        this->send(_next - 1, entry);
+    }
+    return;
+}
+
+// [slot]
+void ReplayEngine::replyFinished(QNetworkReply * reply) {
+
+    reply->deleteLater();
+    if (!_pending.contains(reply))
+        return;
+
+    QPair<ReplayResult, qint64> sent = _pending.take(reply);
+    if (!_running)
+        return;
+
+    ReplayResult & result = sent.first;
+    result.latency = _clock.elapsed() - sent.second;
+    result.replayedStatus =
+        static_cast<StatusCode>(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt());
+    result.replayedDescription = (result.replayedStatus == NO_REPLY) ? reply->errorString() :
+        reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
+
+    ++_replayed;
+    if (result.replayedStatus != result.recordedStatus)
+        ++_statusChanges;
+
+    emit requestReplayed(result);
+    this->sendNext();
+
+    return;
+}
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef REPLAYENGINE_H
+#define REPLAYENGINE_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QObject>
+#include <QTimer>
+#include "journal.h"
+#include "session.h"
+
+struct ReplayResult {
+
+    qint64 entry; // number of entry in journal
+    quint64 recordedID;
+    http::httpMethodType httpMethod;
+    QUrl url;
+    StatusCode recordedStatus;
+    StatusCode replayedStatus;
+    QString replayedDescription;
+    qint64 recordedLatency; // ms (-1 if entry has no timing, see RequestTiming::total())
+    qint64 latency; // ms
+};
+
+// requests stored in journal are sent again to current API server (with current access token);
+// pacing: original inter-arrival times, the same times multiplied by scale or without delays
+// (with given number of requests in flight)
+class ReplayEngine: public QObject {
+
+    Q_OBJECT
+
+    public:
+        enum Pacing { ORIGINAL = 0, SCALED = 1, AS_FAST_AS_POSSIBLE = 2 };
+
+        explicit ReplayEngine(Session * const, QObject * = nullptr);
+        ~ReplayEngine();
+
+        inline bool isRunning() const { return _running; }
+
+        bool start(const qint64, const qint64, const Pacing, const double = 1.0, const int = 1);
+        void stop();
+
+    signals:
+        void requestReplayed(const ReplayResult &) const;
+        void finished(const int, const int) const;
+
+    private slots:
+        void sendNext();
+        void replyFinished(QNetworkReply *);
+
+    private:
+        bool buildRequest(const JournalEntry &, QNetworkRequest &) const;
+        bool send(const qint64, const JournalEntry &);
+        void finish();
+
+        Session * const _session;
+        Journal * const _journal;
+        QNetworkAccessManager * _networkManager;
+        QTimer _timer;
+        QElapsedTimer _clock;
+
+        Pacing _pacing;
+        double _scale;
+        int _maxInFlight;
+        qint64 _next;
+        qint64 _last;
+        QDateTime _firstRecorded;
+        bool _running;
+        int _replayed;
+        int _statusChanges;
+        QHash<QNetworkReply *, QPair<ReplayResult, qint64>> _pending; // reply => (result, time of sending)
+};
+
+#endif // REPLAYENGINE_H
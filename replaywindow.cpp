@@ -0,0 +1,109 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include "replaywindow.h"
+
+ReplayWindow::ReplayWindow(Session * const session, QWidget * parent):
+    QDialog(parent), _engine(new ReplayEngine(session, this)), _totalLatency(0),
+    ui(new Ui_ReplayWindow) {
+
+    ui->setupUi(this, session->journal());
+
+    connect(ui->pacingComboBox, static_cast<void(QComboBox::*)(int)>
+            (&QComboBox::currentIndexChanged), this, &ReplayWindow::changePacing);
+    connect(ui->startButton, &QPushButton::clicked, this, &ReplayWindow::startOrStopReplay);
+    connect(_engine, &ReplayEngine::requestReplayed, this, &ReplayWindow::addResult);
+    connect(_engine, &ReplayEngine::finished, this, &ReplayWindow::replayFinished);
+    connect(ui->closeButton, &QPushButton::clicked, this, &ReplayWindow::close);
+}
+
+// [slot]
+void ReplayWindow::changePacing(const int pacing) {
+
+    ui->scaleSpinBox->setEnabled(pacing == ReplayEngine::SCALED);
+    ui->inFlightSpinBox->setEnabled(pacing == ReplayEngine::AS_FAST_AS_POSSIBLE);
+    return;
+}
+
+// [slot]
+void ReplayWindow::startOrStopReplay() {
+
+    if (_engine->isRunning()) {
+
+        _engine->stop();
+        this->replayFinished(ui->resultsTable->rowCount(), -1);
+        return;
+    }
+
+    ui->resultsTable->setRowCount(0);
+    _totalLatency = 0;
+
+    const bool started = _engine->start(ui->firstEntrySpinBox->value() - 1, ui->lastEntrySpinBox->value() - 1,
+        static_cast<ReplayEngine::Pacing>(ui->pacingComboBox->currentIndex()),
+        ui->scaleSpinBox->value(), ui->inFlightSpinBox->value());
+
+    if (!started) {
+
+        ui->summaryLabel->setText(QStringLiteral("přehrání nelze spustit"));
+        return;
+    }
+
+    ui->startButton->setText(QStringLiteral(" Zastavit "));
+    ui->summaryLabel->setText(QStringLiteral("probíhá přehrávání..."));
+    return;
+}
+
+// [slot]
+void ReplayWindow::addResult(const ReplayResult & result) {
+
+    const int row = ui->resultsTable->rowCount();
+    ui->resultsTable->insertRow(row);
+    _totalLatency += result.latency;
+
+    const QString recorded = QString::number(static_cast<int>(result.recordedStatus));
+    const QString replayed = QString::number(static_cast<int>(result.replayedStatus)) +
+                             QStringLiteral(" ") + result.replayedDescription;
+    // entries journaled before timing was recorded have no latency to compare with
+    const bool recordedLatency = (result.recordedLatency >= 0);
+    const qint64 difference = result.latency - result.recordedLatency;
+    const QStringList description =
+        { QString::number(result.entry + 1), http::convertEnumValueToText(result.httpMethod),
+          result.url.toDisplayString(), recorded, replayed,
+          (recordedLatency) ? QString::number(result.recordedLatency) : QString(),
+          QString::number(result.latency),
+          (recordedLatency) ? ((difference > 0) ? QStringLiteral("+") : QString()) +
+                              QString::number(difference) : QString() };
+
+    // status differs from recorded one
+    const QColor background = (result.replayedStatus == result.recordedStatus) ?
+        QColor(210,255,166) : QColor(255,210,210);
+
+    for (int i = 0; i < description.size(); ++i) {
+
+        QTableWidgetItem * column = new QTableWidgetItem(description.at(i));
+        column->setFlags(column->flags() & ~Qt::ItemIsEditable);
+        if (i == 4)
+            column->setBackground(QBrush(background));
+        ui->resultsTable->setItem(row, i, column);
+    }
+    ui->resultsTable->scrollToBottom();
+
+    return;
+}
+
+// [slot]
+void ReplayWindow::replayFinished(const int replayed, const int statusChanges) {
+
+    ui->startButton->setText(QStringLiteral(" Přehrát "));
+
+    const qint64 average = (replayed > 0) ? _totalLatency / replayed : 0;
+    QString summary = QStringLiteral("přehráno: ") + QString::number(replayed);
+    if (statusChanges >= 0)
+        summary += QStringLiteral(", změn statusu: ") + QString::number(statusChanges);
+    summary += QStringLiteral(", průměrná doba: ") + QString::number(average) + QStringLiteral(" ms");
+    ui->summaryLabel->setText(summary);
+
+    return;
+}
@@ -0,0 +1,34 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef REPLAYWINDOW_H
+#define REPLAYWINDOW_H
+
+#include <QWidget>
+#include "replayengine.h"
+#include "session.h"
+#include "ui/ui_replaywindow.h"
+
+class ReplayWindow: public QDialog {
+
+    Q_OBJECT
+
+    public:
+        explicit ReplayWindow(Session * const, QWidget * = nullptr);
+        ~ReplayWindow() { delete ui; }
+
+    private:
+        ReplayEngine * _engine;
+        qint64 _totalLatency;
+        Ui_ReplayWindow * ui;
+
+    private slots:
+        void startOrStopReplay();
+        void changePacing(const int);
+        void addResult(const ReplayResult &);
+        void replayFinished(const int, const int);
+};
+
+#endif // REPLAYWINDOW_H
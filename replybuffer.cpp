@@ -0,0 +1,129 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QDateTime>
+#include <QDir>
+#include "replybuffer.h"
+
+qint64 ReplyBuffer::_spillThreshold = 16 * 1024 * 1024;
+
+ReplyBuffer::ReplyBuffer(QNetworkReply * const reply): QObject(reply),
+    _reply(reply), _buffer(QByteArray()), _file(nullptr), _size(0) {
+
+    // reply is created when request is handed over to network access manager
+    _timing.queued = QDateTime::currentMSecsSinceEpoch();
+
+    connect(reply, &QNetworkReply::readyRead, this, &ReplyBuffer::readAvailable);
+    connect(reply, &QNetworkReply::uploadProgress, this, &ReplyBuffer::markUploaded);
+    connect(reply, &QNetworkReply::metaDataChanged, this, &ReplyBuffer::markHeadersReceived);
+}
+
+// [slot]
+void ReplyBuffer::markUploaded(qint64 bytesSent, qint64 bytesTotal) {
+
+    // request with body is sent once the whole body has been uploaded
+    if (bytesTotal > 0 && bytesSent == bytesTotal)
+        _timing.sent = QDateTime::currentMSecsSinceEpoch();
+    return;
+}
+
+// [slot]
+void ReplyBuffer::markHeadersReceived() {
+
+    if (_timing.firstByte != 0)
+        return;
+
+    _timing.firstByte = QDateTime::currentMSecsSinceEpoch();
+
+    // announced size (if known and small enough) is allocated at once
+    const qint64 contentLength = _reply->header(QNetworkRequest::ContentLengthHeader).toLongLong();
+    if (_size == 0 && contentLength > 0 && contentLength <= _spillThreshold)
+        _buffer.reserve(static_cast<int>(contentLength));
+
+    return;
+}
+
+// [slot]
+void ReplyBuffer::readAvailable() {
+
+    const QByteArray chunk = _reply->readAll();
+    if (chunk.isEmpty())
+        return;
+
+    _timing.lastByte = QDateTime::currentMSecsSinceEpoch();
+    if (_timing.firstByte == 0)
+        _timing.firstByte = _timing.lastByte;
+
+    _size += chunk.size();
+
+    if (!this->spilled()) {
+
+        _buffer.append(chunk);
+
+        // if temporary file cannot be created, body stays in memory
+        if (_buffer.size() > _spillThreshold)
+            this->spill();
+    }
+    else if (_file->write(chunk) != chunk.size()) {
+
+        // disk full => data written so far are read back and buffering continues in memory
+        _file->seek(0);
+        _buffer = _file->read(_size - chunk.size());
+        _buffer.append(chunk);
+        _file.reset();
+    }
+    return;
+}
+
+bool ReplyBuffer::spill() {
+
+    QSharedPointer<QTemporaryFile> file(
+        new QTemporaryFile(QDir::tempPath() + QStringLiteral("/TAPI_reply_XXXXXX.body")));
+
+    if (!file->open() || file->write(_buffer) != _buffer.size())
+        return false;
+
+    _file = file;
+    _buffer = QByteArray();
+
+    return true;
+}
+
+// returns the whole body; storage is set (to temporary file) if body is memory-mapped
+QByteArray ReplyBuffer::take(QSharedPointer<QTemporaryFile> & storage) {
+
+    // rest of the body (not yet announced by readyRead)
+    this->readAvailable();
+
+    // reply without body ends with its headers
+    if (_timing.lastByte == 0)
+        _timing.lastByte = _timing.firstByte;
+
+    storage.reset();
+
+    if (!this->spilled()) {
+
+        QByteArray contents;
+        contents.swap(_buffer);
+        return contents;
+    }
+
+    _file->flush();
+    uchar * const mappedFile = (_size > 0) ? _file->map(0, _size) : nullptr;
+
+    // mapping failed => body is read back to memory
+    if (mappedFile == nullptr) {
+
+        _file->seek(0);
+        const QByteArray contents = _file->readAll();
+        _file.reset();
+        return contents;
+    }
+
+    storage = _file;
+    _file.reset();
+
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(mappedFile), static_cast<int>(_size));
+}
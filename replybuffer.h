@@ -0,0 +1,55 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef REPLYBUFFER_H
+#define REPLYBUFFER_H
+
+#include <QByteArray>
+#include <QNetworkReply>
+#include <QObject>
+#include <QSharedPointer>
+#include <QTemporaryFile>
+#include "request.h"
+
+// collects body of network reply as it arrives (readyRead) so it does not pile up
+// in reply's own buffer; body exceeding spill threshold is moved to temporary file
+// and handed over memory-mapped (file is kept alive by the responses sharing it);
+// phases of reply (sent, first and last byte) are timed on the way
+class ReplyBuffer: public QObject {
+
+    Q_OBJECT
+
+    public:
+        explicit ReplyBuffer(QNetworkReply * const);
+        ~ReplyBuffer() {}
+
+        inline static qint64 spillThreshold() { return _spillThreshold; }
+        inline static void setSpillThreshold(const qint64 threshold)
+            { _spillThreshold = threshold; return; }
+
+        inline qint64 size() const { return _size; }
+        inline bool spilled() const { return !(_file.isNull()); }
+        inline const RequestTiming & timing() const { return _timing; }
+
+        QByteArray take(QSharedPointer<QTemporaryFile> &);
+
+    private:
+        bool spill();
+
+        static qint64 _spillThreshold;
+
+        QNetworkReply * _reply;
+        QByteArray _buffer;
+        QSharedPointer<QTemporaryFile> _file;
+        qint64 _size;
+        RequestTiming _timing;
+
+    private slots:
+        void readAvailable();
+        void markUploaded(qint64, qint64);
+        void markHeadersReceived();
+};
+
+#endif // REPLYBUFFER_H
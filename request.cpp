@@ -8,31 +8,34 @@
 #include <QJsonObject>
 #include <QJsonValue>
 #include <cstdint>
+#include "jsonscanner.h"
 #include "request.h"
+#include "uuidscanner.h"
 
-uint16_t Communication::_currentID = 0;
+quint64 Communication::_currentID = 0;
 
-Request::Request(const QNetworkRequest & request, const http::httpMethodType httpMethod,
-                 const QByteArray & body): _httpMethod(httpMethod), _acceptFormat(JSON),
-                 _body(body), _request(new QNetworkRequest) {
-
-    *(_request) = request;
-}
+QString RequestTiming::breakdown() const {
 
-Request::Request(const Request & r2) {
+    if (!this->isValid())
+        return QString();
 
-    _httpMethod = r2._httpMethod;
-    _contentType = r2._contentType;
-    _acceptFormat = r2._acceptFormat;
-    _body = r2._body;
+    const auto text = [](const qint64 duration) {
+        return (duration < 0) ? QStringLiteral("–") : QString::number(duration); };
 
-    _request = new(QNetworkRequest);
-    *(_request) = r2.request();
+    return QStringLiteral("celkem ") + QString::number(this->total()) + QStringLiteral(" ms (odeslání ") +
+           text(this->sending()) + QStringLiteral(", server ") + text(this->waiting()) +
+           QStringLiteral(", příjem ") + text(this->receiving()) + QStringLiteral(", zpracování ") +
+           text(this->processing()) + QStringLiteral(")");
 }
 
+Request::Request(const QNetworkRequest & request, const http::httpMethodType httpMethod,
+                 const QByteArray & body): _httpMethod(httpMethod), _acceptFormat(JSON),
+                 _body(body), _request(request) {}
+
 Response::Response(const QByteArray & contents, const QList<QNetworkReply::RawHeaderPair> & headers,
                    const QVariant & ID, const StatusCode & code, const QString & status):
-    _statusCode(code), _status(status), _headers(headers), _ID(ID), _response(contents) {
+    _statusCode(code), _status(status), _headers(headers), _ID(ID), _response(contents),
+    _bodyParsed(false) {
 
     this->_stateAttributes.pageCount = QString();
     this->_stateAttributes.rowCount = QString();
@@ -41,13 +44,66 @@ Response::Response(const QByteArray & contents, const QList<QNetworkReply::RawHe
     this->_stateAttributes.stackTrace = QString();
 }
 
+bool Response::compressBody() {
+
+    // parsed body is dropped as well (it is parsed again from stored body on next use)
+    const bool bodyWasParsed = _bodyParsed;
+    this->dropParsedBody();
+
+    if (this->isFileBacked())
+        return bodyWasParsed;
+
+    return (_response.compress() || bodyWasParsed);
+}
+
+bool Response::archiveBody(const QSharedPointer<HistoryArchive> & archive) {
+
+    this->dropParsedBody();
+
+    if (this->isFileBacked())
+        return false;
+
+    return _response.archive(archive);
+}
+
+const QJsonDocument & Response::document() const {
+
+    if (!_bodyParsed) {
+
+        _document = QJsonDocument::fromJson(_response.data());
+        _body = _document.object();
+        _bodyParsed = true;
+    }
+    return _document;
+}
+
+// body which has not been parsed yet is not cached (querying or comparing whole history must not
+// hold documents of all responses in memory); returned value keeps the document alive
+QJsonValue Response::jsonRoot() const {
+
+    const QJsonDocument document =
+        (_bodyParsed) ? _document : QJsonDocument::fromJson(_response.data());
+
+    if (document.isArray())
+        return document.array();
+    if (document.isObject())
+        return document.object();
+
+    return QJsonValue(QJsonValue::Undefined);
+}
+
+QVector<QJsonValue> Response::query(const JsonQuery & compiledQuery) const {
+
+    const QJsonValue root = this->jsonRoot();
+    return (root.isUndefined()) ? QVector<QJsonValue>() : compiledQuery.evaluate(root);
+}
+
 QString Response::parseBody(const QString & tagName) const {
 
-    const QJsonDocument currentJsonDocument = QJsonDocument::fromJson(_response);
-    if (currentJsonDocument.isNull())
+    if (!this->bodyIsJson())
         return QString();
 
-    const QJsonObject currentJsonObject(currentJsonDocument.object());
+    const QJsonObject & currentJsonObject = this->body();
     if (currentJsonObject.isEmpty())
         return QString();
 
@@ -71,60 +127,160 @@ QString Response::parseBody(const QString & tagName) const {
     return QString();
 }
 
-QString Response::dataFromBody(QList<QString> & recordIDs) const {
+// reads top-level state attributes without building DOM (for bodies kept in file)
+StateAttributes Response::scanStateAttributes() const {
+
+    StateAttributes attributes;
+
+    const QByteArray contents = _response.data();
+    JsonScanner scanner(contents);
+    if (!scanner.enterObject())
+        return attributes;
+
+    QString key;
+    while (scanner.nextKey(key)) {
+
+        QString * attribute = nullptr;
+        if (key == QStringLiteral("PageCount"))
+            attribute = &(attributes.pageCount);
+        else if (key == QStringLiteral("RowCount"))
+            attribute = &(attributes.rowCount);
+        else if (key == QStringLiteral("Status"))
+            attribute = &(attributes.status);
+        else if (key == QStringLiteral("Message"))
+            attribute = &(attributes.message);
+        else if (key == QStringLiteral("StackTrace"))
+            attribute = &(attributes.stackTrace);
+
+        if (attribute == nullptr || scanner.atObject() || scanner.atArray()) {
+            scanner.skipValue();
+            continue;
+        }
+
+        // strings are unescaped, numbers and literals are taken as they are (null = empty)
+        if (scanner.atString())
+            scanner.readString(*attribute);
+        else {
+
+            qint64 begin = 0;
+            qint64 end = 0;
+            if (scanner.skipValue(&begin, &end)) {
+
+                const QString literal = QString::fromLatin1(scanner.data() + begin, static_cast<int>(end - begin));
+                if (literal != QStringLiteral("null"))
+                    *attribute = literal;
+            }
+        }
+    }
+    return attributes;
+}
+
+// record IDs (POST/PUT/DELETE) are read from raw body, data section is returned as indented text
+QString Response::dataFromBody(QVector<QUuid> & recordIDs) const {
 
-    const QJsonDocument currentJsonDocument = QJsonDocument::fromJson(_response);
-    if (currentJsonDocument.isNull())
-        return QString();
+    qint64 begin = 0;
+    qint64 end = 0;
+    bool onlyRecordIDs = false;
+    const int noOfRecordIDs = recordIDs.size();
 
-    const QJsonObject currentJsonObject(currentJsonDocument.object());
-    if (currentJsonObject.isEmpty())
+    if (!this->locateData(begin, end, recordIDs, &onlyRecordIDs))
         return QString();
 
-    const QJsonValue currentJsonValue = currentJsonObject["Data"];
-    if (currentJsonValue.isNull())
+    const QByteArray data = this->response().mid(static_cast<int>(begin), static_cast<int>(end - begin));
+
+    // json array contains json values as elements (POST/PUT) => no need to reformat;
+    // IDs are sliced from body as they are (case of hex digits is kept)
+    if (onlyRecordIDs) {
+
+        QString contents = QStringLiteral("[\n");
+        contents.reserve((recordIDs.size() - noOfRecordIDs) * (UuidScanner::canonicalLength + 8) + 4);
+        int quote = data.indexOf('"');
+        while (quote >= 0) {
+
+            const int closingQuote = data.indexOf('"', quote + 1);
+            if (closingQuote < 0)
+                break;
+
+            if (contents.size() > 2)
+                contents += QStringLiteral(",\n");
+            contents += QStringLiteral("    ") +
+                        QString::fromLatin1(data.constData() + quote, closingQuote - quote + 1);
+            quote = data.indexOf('"', closingQuote + 1);
+        }
+        contents += QStringLiteral("\n]\n");
+
+        return contents;
+    }
+
+    // data section contains json value (DELETE)
+    if (data.startsWith('"')) {
+
+        QString contents;
+        JsonScanner scanner(data);
+        scanner.readString(contents);
+        return contents;
+    }
+
+    // data section contains json array (GET) or json object (no method)
+    const QJsonDocument dataDocument = QJsonDocument::fromJson(data);
+    if (dataDocument.isNull())
         return QString();
 
-    // data section contains json array
-    if (currentJsonValue.type() == QJsonValue::Array) {
+    return dataDocument.toJson(QJsonDocument::Indented);
+}
+
+// locates Data section in raw body without building DOM (for very large bodies);
+// record IDs are collected the same way as in dataFromBody()
+bool Response::locateData(qint64 & begin, qint64 & end, QVector<QUuid> & recordIDs,
+                          bool * const onlyRecordIDs) const {
 
-        const QJsonArray data = currentJsonValue.toArray();
-        QJsonDocument dataDocument;
-        dataDocument.setArray(data);
+    const QByteArray data = _response.data();
+    JsonScanner scanner(data);
+    if (!scanner.enterObject())
+        return false;
 
-        for (auto it: data) {
+    if (onlyRecordIDs != nullptr)
+        *onlyRecordIDs = false;
 
-          // json array contains json values as elements (POST/PUT)
-          if (it.type() == QJsonValue::String && this->containsValidID(it.toString()))
-              recordIDs.push_back(it.toString());
+    QString key;
+    while (scanner.nextKey(key)) {
 
-          // json array contains json object (GET)
-          if (it.type() == QJsonValue::Object)
-            ; // no action required
+        if (key != QStringLiteral("Data")) {
+            scanner.skipValue();
+            continue;
         }
 
-        return dataDocument.toJson(QJsonDocument::Indented);
-    }
+        scanner.peek();
+        begin = scanner.position();
 
-    // data section contains json object (no method)
-    if (currentJsonValue.type() == QJsonValue::Object) {
+        // data section contains json array (IDs are array's string elements)
+        if (scanner.atArray()) {
 
-        const QJsonObject data = currentJsonValue.toObject();
-        QJsonDocument dataDocument;
-        dataDocument.setObject(data);
+            const int otherElements =
+                UuidScanner::readArray(data.constData() + begin, data.size() - begin, recordIDs, &end);
+            if (otherElements < 0)
+                return false;
 
-        return dataDocument.toJson(QJsonDocument::Indented);
-    }
+            end += begin;
+            if (onlyRecordIDs != nullptr)
+                *onlyRecordIDs = (otherElements == 0 && end - begin > 2);
+            return true;
+        }
 
-    // data section contains value (DELETE)
-    if (currentJsonValue.type() == QJsonValue::String) {
+        // data section contains value (DELETE)
+        if (scanner.atString()) {
 
-        const QString contents = currentJsonValue.toString();
-        if (this->containsValidID(contents))
-            recordIDs.push_back(contents);
+            qint64 valueEnd = 0;
+            QUuid recordID;
+            if (scanner.skipValue(nullptr, &valueEnd) &&
+                UuidScanner::read(data.constData() + begin + 1, valueEnd - begin - 2, recordID))
+                recordIDs.push_back(recordID);
+        }
+        else
+            scanner.skipValue();
 
-        return contents;
+        end = scanner.position();
+        return !scanner.hasError();
     }
-
-    return QString();
+    return false;
 }
@@ -7,12 +7,20 @@
 #define REQUEST_H
 
 #include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QSharedPointer>
+#include <QTemporaryFile>
 #include <QUuid>
+#include <QVector>
 #include "methods.h"
+#include "jsonquery.h"
+#include "storedbody.h"
 
-enum RequestType { API = 1, TOKEN = 2, ENDPOINTS = 3, SWAGGER = 4, OTHER = 5 };
+enum RequestType { API = 1, TOKEN = 2, ENDPOINTS = 3, SWAGGER = 4, OTHER = 5, SWAGGER_DOC = 6,
+                   PAGE = 7 };
 
 enum ContentType { NOT_USED = -1, JSON = 0, XML = 1, URL_ENCODED = 2, HTML = 3 };
 
@@ -46,7 +54,9 @@ const static struct AuxiliaryEndpoint {
 
 } tokenEndpoint = { http::POST, URL_ENCODED, NOT_USED, QStringLiteral("/connect/token"), false },
   endpointsEndpoint = { http::GET, JSON, NOT_USED, QStringLiteral("/Admin/Roles/Endpoints"), false },
-  swagger =  { http::GET, HTML, NOT_USED, QStringLiteral("/swaggerDoc/index.html"), false };
+  swagger =  { http::GET, HTML, NOT_USED, QStringLiteral("/swaggerDoc/index.html"), false },
+  // endpoint (path) is taken from swagger docs' index page
+  swaggerDoc = { http::GET, NOT_USED, JSON, QString(), false };
 
 class Request {
 
@@ -55,21 +65,26 @@ class Request {
            { return (static_cast<QNetworkRequest::Attribute>(
                  (static_cast<uint16_t>(QNetworkRequest::User)) + number)); }
 
-        Request(): _acceptFormat(JSON), _request(new QNetworkRequest) {}
+        Request(): _acceptFormat(JSON) {}
         Request(const QNetworkRequest &, const http::httpMethodType, const QByteArray &);
-        Request(const Request &);
-        ~Request() { delete _request; }
+        ~Request() {}
 
         inline http::httpMethodType httpMethod() const { return _httpMethod; }
-        inline QByteArray body() const { return _body; }
-        inline QNetworkRequest request() const { return *(_request); }
+        inline QByteArray body(bool * const ok = nullptr) const { return _body.data(ok); }
+        inline QNetworkRequest request() const { return _request; }
+
+        // see Session::enforceHistoryBudget()
+        inline qint64 bodyMemoryUsage() const { return _body.memoryUsage(); }
+        inline bool compressBody() { return _body.compress(); }
+        inline bool archiveBody(const QSharedPointer<HistoryArchive> & archive)
+            { return _body.archive(archive); }
 
     private:
         http::httpMethodType _httpMethod;
         ContentType _contentType;
         ContentType _acceptFormat;
-        QByteArray _body;
-        QNetworkRequest * _request;
+        StoredBody _body;
+        QNetworkRequest _request; // implicitly shared (copies of request are cheap)
 };
 
 struct StateAttributes {
@@ -84,7 +99,7 @@ struct StateAttributes {
 class Response {
 
     public:
-        Response() {}
+        Response(): _bodyParsed(false) {}
         Response(const QByteArray &, const QList<QNetworkReply::RawHeaderPair> &,
                  const QVariant &, const StatusCode & = OK, const QString & = "OK");
         ~Response() {}
@@ -92,29 +107,77 @@ class Response {
         inline StatusCode statusCode() const { return _statusCode; }
         inline QString statusDescription() const { return _status; }
         inline StateAttributes stateAttributes() const { return _stateAttributes; }
-        inline const QList<QNetworkReply::RawHeaderPair> & headers() { return _headers; }
-        inline QByteArray response() const { return _response; }
+        inline const QList<QNetworkReply::RawHeaderPair> & headers() const { return _headers; }
+        inline QByteArray response(bool * const ok = nullptr) const { return _response.data(ok); }
+
+        // body is parsed on first use only (copies made afterwards share the result)
+        inline bool bodyIsJson() const { return !(this->document().isNull()); }
+        inline const QJsonObject & body() const { this->document(); return _body; }
+
+        // body spilled to disk by ReplyBuffer is memory-mapped from temporary file
+        inline bool isFileBacked() const { return !(_storage.isNull()); }
+
+        // body kept in (mapped) file does not count (see Session::enforceHistoryBudget())
+        inline qint64 bodyMemoryUsage() const
+            { return (this->isFileBacked()) ? 0 : _response.memoryUsage(); }
+        bool compressBody();
+        bool archiveBody(const QSharedPointer<HistoryArchive> &);
+        inline void dropParsedBody()
+            { _bodyParsed = false; _document = QJsonDocument(); _body = QJsonObject(); return; }
 
         QString parseBody(const QString &) const;
-        QString dataFromBody(QList<QString> &) const;
+        QJsonValue jsonRoot() const;
+        QVector<QJsonValue> query(const JsonQuery &) const;
+        StateAttributes scanStateAttributes() const;
+        QString dataFromBody(QVector<QUuid> &) const;
+        bool locateData(qint64 &, qint64 &, QVector<QUuid> &, bool * const = nullptr) const;
 
         inline void setResponse(const QByteArray & response)
-            { _response = response; return; }
+            { _response = StoredBody(response); _storage.reset(); this->dropParsedBody(); return; }
+        inline void setStorage(const QSharedPointer<QTemporaryFile> & storage)
+            { _storage = storage; return; }
         inline void setTestStatus()
             { _statusCode = TEST; _status = QStringLiteral("Test mode"); return; }
         inline void setStateAttribs(const StateAttributes & attribs)
             { _stateAttributes = attribs; return; }
 
     private:
-        inline bool containsValidID(const QString & idFromResponse) const
-            { const QUuid id(idFromResponse); return !(id.isNull()); }
+        const QJsonDocument & document() const;
 
         StatusCode _statusCode;
         QString _status;
         StateAttributes _stateAttributes;
         QList<QNetworkReply::RawHeaderPair> _headers;
         QVariant _ID;
-        QByteArray _response;
+        StoredBody _response;
+        QSharedPointer<QTemporaryFile> _storage;
+        mutable bool _bodyParsed;
+        mutable QJsonDocument _document;
+        mutable QJsonObject _body;
+};
+
+// timestamps (ms since epoch, 0 = not reached) of message's phases (see ReplyBuffer);
+// request is sent when its body has been uploaded (request without body has no such
+// moment => sent stays 0 and waiting is measured from queueing)
+struct RequestTiming {
+
+    qint64 queued = 0; // handed over to network access manager
+    qint64 sent = 0;
+    qint64 firstByte = 0; // headers received
+    qint64 lastByte = 0; // last part of body received
+    qint64 processed = 0; // response assigned to request (see Session::setReplyToCurrentRequest)
+
+    // duration in ms (-1 if either of timestamps is missing)
+    inline static qint64 span(const qint64 from, const qint64 to)
+        { return (from > 0 && to >= from) ? to - from : -1; }
+    inline bool isValid() const { return (queued > 0 && processed > 0); }
+    inline qint64 total() const { return span(queued, processed); }
+    inline qint64 sending() const { return span(queued, sent); }
+    inline qint64 waiting() const { return span((sent > 0) ? sent : queued, firstByte); }
+    inline qint64 receiving() const { return span(firstByte, lastByte); }
+    inline qint64 processing() const { return span(lastByte, processed); }
+
+    QString breakdown() const;
 };
 
 class Communication {
@@ -122,15 +185,17 @@ class Communication {
     public:
         Communication() {}
         Communication(const Request & request):
-             _ID(request.request().attribute(Request::userAttribute(1)).toInt()),
+             _ID(request.request().attribute(Request::userAttribute(1)).toULongLong()),
              _createDate(QDateTime::currentDateTime()), _request(request) { ++(_currentID); }
         ~Communication() {}
 
-        static uint16_t _currentID;
-        inline uint16_t ID() const { return _ID; }
+        static quint64 _currentID;
+        inline quint64 ID() const { return _ID; }
         inline const QDateTime & createDate() const { return _createDate; }
         inline Request request() const { return _request; }
-        inline Response response() const { return _response; }
+        inline const Response & response() const { return _response; }
+        inline const RequestTiming & timing() const { return _timing; }
+        inline void setTiming(const RequestTiming & timing) { _timing = timing; return; }
         inline void setLastReplyContent(const QByteArray & replyContent)
             { this->_response.setResponse(replyContent); return; }
         inline void setLastReplyTestStatus() { this->_response.setTestStatus(); return; }
@@ -138,11 +203,23 @@ class Communication {
             { this->_response.setStateAttribs(stateAttribs); return; }
         inline void setReply(const Response & reply) { _response = reply; return; }
 
+        inline qint64 memoryUsage() const
+            { return (_request.bodyMemoryUsage() + _response.bodyMemoryUsage()); }
+        inline bool compress()
+            { const bool requestCompressed = _request.compressBody();
+              return (_response.compressBody() || requestCompressed); }
+        inline bool archive(const QSharedPointer<HistoryArchive> & archive)
+            { const bool requestArchived = _request.archiveBody(archive);
+              return (_response.archiveBody(archive) || requestArchived); }
+        // parsed reply is kept for the latest messages only (see Session::newMessage())
+        inline void dropParsedReply() { _response.dropParsedBody(); return; }
+
     private:
-        uint16_t _ID;
+        quint64 _ID;
         QDateTime _createDate;
         Request _request;
         Response _response;
+        RequestTiming _timing;
 };
 
 #endif // REQUEST_H
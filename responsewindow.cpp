@@ -3,6 +3,8 @@
  This program is distributed under the terms of the GNU General Public License.
 *******************************************************************************/
 
+#include <QMessageBox>
+#include "datatablewindow.h"
 #include "requestwindow.h"
 #include "responsewindow.h"
 
@@ -11,16 +13,14 @@ ResponseWindow::ResponseWindow(const QNetworkReply * const reply, Session * cons
     _httpMethod(reply->operation()), _currentSession(currentSession), ui(new Ui_ResponseWindow) {
 
     // match current response to previously saved record
-    QVector<Communication>::reverse_iterator it = _currentSession->communication().rbegin();
-    for (; it != _currentSession->communication().rend(); ++it)
-        if (it->ID() == _ID.toInt())
-            break;
-
-    ui->setupUi(this, reply, _ID, _recordIDs, it.base()-1);
+    ui->setupUi(this, reply, _ID, _recordIDs,
+                _currentSession->findCorrespondingRequest(_ID.toULongLong()));
 
     connect(ui->httpMethodButton, &QPushButton::clicked,
             this, &ResponseWindow::displayRequestWindow);
+    connect(ui->dataTableButton, &QPushButton::clicked, this, &ResponseWindow::displayDataTableWindow);
     connect(ui->verifyButton, &QPushButton::clicked, this, &ResponseWindow::verifyResults);
+    connect(ui->jsonQueryLineEdit, &QLineEdit::returnPressed, this, &ResponseWindow::evaluateJsonQuery);
     connect(ui->closeButton, &QPushButton::clicked, this, &ResponseWindow::close);
 }
 
@@ -71,8 +71,62 @@ void ResponseWindow::verifyResults() {
 int ResponseWindow::displayRequestWindow() {
 
     const Request & correspondingRequest =
-        _currentSession->findCorrespondingRequest(_ID.toInt())->request();
+        _currentSession->findCorrespondingRequest(_ID.toULongLong())->request();
 
     RequestWindow requestWindow(correspondingRequest, _ID, this);
     return requestWindow.exec();
 }
+
+// [slot]
+int ResponseWindow::displayDataTableWindow() {
+
+    const Communication * const comm = _currentSession->findCorrespondingRequest(_ID.toULongLong());
+    if (comm == nullptr)
+        return QDialog::Rejected;
+
+    bool bodyRead = true;
+    const QByteArray contents = comm->response().response(&bodyRead);
+    if (!bodyRead) {
+
+        QMessageBox::warning(this, QStringLiteral("Datová tabulka"),
+                             QStringLiteral("Tělo odpovědi se nepodařilo načíst z archivu historie."));
+        return QDialog::Rejected;
+    }
+
+    qint64 dataBegin = 0;
+    qint64 dataEnd = 0;
+    QVector<QUuid> recordIDs;
+    if (!comm->response().locateData(dataBegin, dataEnd, recordIDs))
+        return QDialog::Rejected;
+
+    // table is built from raw body (not from parsed document)
+    DataTable table;
+    if (!table.read(contents.constData() + dataBegin, dataEnd - dataBegin))
+        return QDialog::Rejected;
+
+    DataTableWindow dataTableWindow(table, comm->request().request().url().path(), this);
+    return dataTableWindow.exec();
+}
+
+// [slot]
+void ResponseWindow::evaluateJsonQuery() {
+
+    const QString expression = ui->jsonQueryLineEdit->text().trimmed();
+    if (expression.isEmpty()) {
+
+        ui->jsonQueryResultTextEdit->setHidden(true);
+        return;
+    }
+
+    if (expression != _jsonQuery.expression())
+        _jsonQuery = JsonQuery(expression);
+
+    const Communication * const comm = _currentSession->findCorrespondingRequest(_ID.toULongLong());
+    if (comm == nullptr)
+        return;
+
+    ui->jsonQueryResultTextEdit->setPlainText((_jsonQuery.isValid()) ?
+        JsonQuery::toText(comm->response().query(_jsonQuery)) : _jsonQuery.error());
+    ui->jsonQueryResultTextEdit->setHidden(false);
+    return;
+}
@@ -22,12 +22,15 @@ class ResponseWindow: public QDialog {
     private slots:
         void verifyResults();
         int displayRequestWindow();
+        int displayDataTableWindow();
+        void evaluateJsonQuery();
 
     private:
         const QVariant _ID; // request ID
-        QList<QString> _recordIDs; // IDs of inserted/deleted records
+        QVector<QUuid> _recordIDs; // IDs of inserted/deleted records
         QNetworkAccessManager::Operation _httpMethod;
         Session * const _currentSession;
+        JsonQuery _jsonQuery; // compiled on change of expression only
         Ui_ResponseWindow * ui;
 };
 
@@ -4,44 +4,76 @@
 *******************************************************************************/
 
 #include <QApplication>
-#include <QEventLoop>
+#include <QCryptographicHash>
 #include <QFile>
-#include <QInputDialog>
 #include <QIODevice>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QMessageBox>
+#include <QNetworkDiskCache>
 #include <QNetworkProxy>
 #include <QRegularExpression>
+#include <QStandardPaths>
 #include <QUrl>
 #include <QUuid>
 #include <algorithm>
+#include "replybuffer.h"
 #include "session.h"
 #include "tables.h"
 #include "types.h"
+#include "uuidscanner.h"
 
 const QString Session::jsonFileType = QStringLiteral("json"); // config, Swagger
 const QRegularExpression Session::swaggerUrlsRegex =
     QRegularExpression(QStringLiteral("\"urls\":\\[\\{.+\\}\\]"));
+const QRegularExpression Session::pagedPathRegex =
+    QRegularExpression(QStringLiteral("^(.*)/(\\d+)/(\\d+)$"));
+const int Session::maxConcurrentPages = 4;
+const int Session::uncompressedHistoryEntries = 20;
 
 Session::Session():
 
     _networkManager(new QNetworkAccessManager), _endpoints(QVector<Endpoint>()),
+    _swaggerLoader(new SwaggerLoader(this)),
     _accessToken(new Token), _connectionSettings(new ConnectionS5), _apiServer(new ConnectionApi),
     _db(new Database), _credentials(new Credentials), _sourceChanged(false), _fileName(QString()),
-    _fileContents(QByteArray()), _configFileLastDir(QString()), _swaggerFileLastDir(QString()),
+    _fileContents(QByteArray()), _endpointsSourceHash(QByteArray()),
+    _configFileLastDir(QString()), _swaggerFileLastDir(QString()),
+    _historyMemoryBudget(64 * 1024 * 1024), _historyMemoryUsage(0),
+    _firstUncompressed(0), _firstUnarchived(0), _journal(new Journal),
     _useProxy(false), _testModeEnabled(false) {
 
     setupProxy(_useProxy);
 
+    // auxiliary documents (swagger, list of endpoints) are kept between sessions
+    // and only revalidated (If-None-Match, If-Modified-Since) => 304 is served from disk
+    QNetworkDiskCache * responseCache = new QNetworkDiskCache(_networkManager);
+    responseCache->setCacheDirectory(
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/http"));
+    _networkManager->setCache(responseCache);
+
     QObject::connect(_networkManager, &QNetworkAccessManager::finished,
                      this, &Session::replyFinished);
 
+    QObject::connect(_swaggerLoader, &SwaggerLoader::progressChanged,
+                     this, &Session::swaggerLoadingProgress);
+    QObject::connect(_swaggerLoader, &SwaggerLoader::pathsIndexed,
+                     this, &Session::swaggerPathsIndexed);
+    QObject::connect(_swaggerLoader, &SwaggerLoader::finished,
+                     this, &Session::swaggerLoaded);
+    QObject::connect(_swaggerLoader, &SwaggerLoader::failed,
+                     this, &Session::swaggerNotLoaded);
+
+    // every change of reply's body is announced (see setReplyToCurrentRequest(), test mode)
+    QObject::connect(this, &Session::messageChanged,
+                     this, &Session::accountChangedMessage);
+
     QMetaObject::connectSlotsByName(this);
 }
 
 Session::~Session() {
 
+    delete _journal;
     delete _credentials;
     delete _db;
     delete _apiServer;
@@ -95,8 +127,55 @@ void Session::setValues(const QString & s5UserName, const QString & agendaDbName
 void Session::newMessage(const Request & request) {
 
     const Communication message(request);
+    _communicationIndex.insert(message.ID(), _communication.size());
     _communication.push_back(message);
+    _historyEntryUsage.push_back(0);
+    this->updateHistoryUsage(_communication.size() - 1);
+    emit messageAdded(_communication.size() - 1);
+
+    // parsed reply (DOM) is not counted in budget => only the latest messages keep it
+    const int leavingEntry = _communication.size() - 1 - uncompressedHistoryEntries;
+    if (leavingEntry >= 0)
+        _communication[leavingEntry].dropParsedReply();
+
+    this->enforceHistoryBudget();
+    return;
+}
+
+// running total is adjusted by the change of given message's memory usage
+void Session::updateHistoryUsage(const int position) {
+
+    const qint64 usage = _communication.at(position).memoryUsage();
+    _historyMemoryUsage += usage - _historyEntryUsage.at(position);
+    _historyEntryUsage[position] = usage;
+    return;
+}
+
+// bodies of older messages are compressed and (if that is not enough) moved to disk;
+// the latest messages are kept as they are (their replies may still be processed)
+void Session::enforceHistoryBudget() {
+
+    const int oldEntries = _communication.size() - uncompressedHistoryEntries;
 
+    for (; _firstUncompressed < oldEntries && _historyMemoryUsage > _historyMemoryBudget;
+         ++_firstUncompressed) {
+
+        _communication[_firstUncompressed].compress();
+        this->updateHistoryUsage(_firstUncompressed);
+    }
+
+    if (_historyMemoryUsage <= _historyMemoryBudget)
+        return;
+
+    if (_historyArchive.isNull())
+        _historyArchive.reset(new HistoryArchive);
+
+    for (; _firstUnarchived < oldEntries && _historyMemoryUsage > _historyMemoryBudget;
+         ++_firstUnarchived) {
+
+        _communication[_firstUnarchived].archive(_historyArchive);
+        this->updateHistoryUsage(_firstUnarchived);
+    }
     return;
 }
 
@@ -110,14 +189,14 @@ QByteArray Session::currentRequestBody() const {
     return _communication.last().request().body();
 }
 
-Response Session::lastReply(const uint16_t ID) {
+const Response & Session::lastReply(const quint64 ID) {
 
     Communication * comm = this->findCorrespondingRequest(ID);
 
     return (comm->response());
 }
 
-QByteArray Session::lastReplyContents(const uint16_t ID) {
+QByteArray Session::lastReplyContents(const quint64 ID) {
 
     Communication * comm = this->findCorrespondingRequest(ID);
 
@@ -126,22 +205,34 @@ QByteArray Session::lastReplyContents(const uint16_t ID) {
 
 bool Session::setReplyToCurrentRequest(QNetworkReply * const reply) {
 
-    const QByteArray replyContents = reply->readAll();
+    // body collected while receiving (see sendGetRequestAndWaitForReply) is taken over
+    QSharedPointer<QTemporaryFile> storage;
+    ReplyBuffer * const buffer = reply->findChild<ReplyBuffer *>(QString(), Qt::FindDirectChildrenOnly);
+    const QByteArray replyContents = (buffer != nullptr) ? buffer->take(storage) : reply->readAll();
+    RequestTiming timing = (buffer != nullptr) ? buffer->timing() : RequestTiming();
+
     const QList<QNetworkReply::RawHeaderPair> headers = reply->rawHeaderPairs();
     const StatusCode statusCode =
             static_cast<StatusCode>(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt());
     const QString status = reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
     const QVariant ID = reply->request().attribute(Request::userAttribute(1));
 
-    const Response newResponse(replyContents, headers, ID, statusCode, status);
+    Response newResponse(replyContents, headers, ID, statusCode, status);
+    newResponse.setStorage(storage);
 
     // assign response to corresponding request
     // (responses may not be received in the same order in which requests were sent)
-    Communication * comm = this->findCorrespondingRequest(ID.toInt());
+    Communication * comm = this->findCorrespondingRequest(ID.toULongLong());
     if (comm == nullptr)
         return false;
 
     comm->setReply(newResponse);
+    timing.processed = QDateTime::currentMSecsSinceEpoch();
+    comm->setTiming(timing);
+    // completed message is kept between sessions (see LogWindow, Journal::isStorable())
+    _journal->append(*comm);
+    emit messageChanged(_communicationIndex.value(ID.toULongLong()));
+
     return true;
 }
 
@@ -159,23 +250,17 @@ err::fileError Session::openFile(const QString & selectedFile) {
     return err::NO_ERROR;
 }
 
-Communication * Session::findCorrespondingRequest(const uint16_t ID) {
-
-    QVector<Communication>::reverse_iterator it;
+// history is never shortened => position of message in _communication does not change
+Communication * Session::findCorrespondingRequest(const quint64 ID) {
 
-    for (it =_communication.rbegin(); it != _communication.rend(); ++it)
-        if (it->ID() == ID)
+    const int position = _communicationIndex.value(ID, -1);
 
-            // base() returns iterator to the element that is next
-            // to the element the reverse_iterator is currently pointing to
-            return it.base()-1;
-
-    return nullptr;
+    return (position < 0) ? nullptr : &(_communication[position]);
 }
 
 QString Session::getTableName(const QVariant & ID) {
 
-    Communication * const comm = this->findCorrespondingRequest(ID.toInt());
+    Communication * const comm = this->findCorrespondingRequest(ID.toULongLong());
     const QString url = comm->request().request().url().toString();
 
     QString endpointName = QString();
@@ -194,7 +279,7 @@ QString Session::getTableName(const QVariant & ID) {
     return tableName;
 }
 
-Session::State Session::verifyTableRecords(const QString & tableName, const QList<QString> & recordIDs,
+Session::State Session::verifyTableRecords(const QString & tableName, const QVector<QUuid> & recordIDs,
                                  const QNetworkAccessManager::Operation & method) {
 
     // use agenda/document db
@@ -225,8 +310,9 @@ Session::State Session::verifyTableRecords(const QString & tableName, const QLis
     if (connectionEstablished) {
 
         QString IDs;
-        for (auto it: recordIDs)
-            IDs += QStringLiteral("'") + it + QStringLiteral("',");
+        IDs.reserve(recordIDs.size() * (UuidScanner::canonicalLength + 3));
+        for (const auto & it: recordIDs)
+            IDs += QStringLiteral("'") + it.toString(QUuid::WithoutBraces) + QStringLiteral("',");
         IDs.chop(1);
 
         const QString queryStringCore =
@@ -311,42 +397,102 @@ bool Session::parseConfigFile() {
 
 bool Session::parseSwaggerFile() {
 
-    const QJsonDocument swaggerFileJson = QJsonDocument::fromJson(this->_fileContents);
-    if (swaggerFileJson.isNull())
+    if (!SwaggerLoader::load(this->_fileContents, _swaggerModel))
         return false;
 
-    // whole document
-    QJsonObject swaggerObjectJson(swaggerFileJson.object());
-    // paths section
-    const QJsonObject paths = swaggerObjectJson["paths"].toObject();
-    const QJsonObject definitions = swaggerObjectJson["definitions"].toObject();
-    if (paths.isEmpty() || definitions.isEmpty())
+    // source is not needed anymore (everything required is held by the model)
+    this->_fileContents.clear();
+
+    this->applySwaggerModel();
+    return true;
+}
+
+bool Session::loadSwaggerFile() {
+
+    if (this->_fileContents.isEmpty())
         return false;
 
+    // parsing is done on worker thread, model is handed over in swaggerLoaded()
+    _swaggerLoader->start(this->_fileContents);
+    this->_fileContents.clear();
+
+    emit swaggerLoadingStarted();
+    return true;
+}
+
+void Session::applySwaggerModel() {
+
+    this->applySwaggerOperations();
+    this->applySwaggerDefinitions();
+
+    return;
+}
+
+void Session::applySwaggerOperations() {
+
     for (QVector<Endpoint>::iterator it = _endpoints.begin(); it < _endpoints.end(); ++it) {
 
-        const QString objectName = "/" + it->path();
         const QString httpMethod = it->method().toLower();
-        const QJsonObject path = paths[objectName].toObject();
-        const QJsonObject method = path[httpMethod].toObject();
-        const QString summary = method["summary"].toString();
+        const SwaggerOperation operation = _swaggerModel.operation("/" + it->path(), httpMethod);
 
-        if (it->propertiesAreNotSet()) {
+        // unchanged operation => endpoint (incl. values supplied by user) is kept
+        const QByteArray fingerprint = operation.fingerprint();
+        if (fingerprint == it->operationFingerprint())
+            continue;
 
-            it->setSummary(summary);
-            it->setParams(method);
+        it->setSummary(operation.summary());
+        it->setParams(operation.parameters());
 
-            const http::dataFlow dtoObjectType =
-                http::httpMethods[httpMethod.toUpper()]._dtoObjectType;
-            if (dtoObjectType == http::INPUT)
-                it->setDtoInputDefinitionLink(method);
-            if (dtoObjectType == http::OUTPUT)
-                it->setDtoOutputDefinitionLink(method);
+        const http::dataFlow dtoObjectType =
+            http::httpMethods[httpMethod.toUpper()]._dtoObjectType;
+        it->setDtoLabel(operation.dtoLabel(dtoObjectType));
+        it->setOperationFingerprint(fingerprint);
+    }
+    return;
+}
 
-            it->setDtoAttributes(definitions, dtoObjectType);
-        }
+void Session::applySwaggerDefinitions() {
+
+    for (QVector<Endpoint>::iterator it = _endpoints.begin(); it < _endpoints.end(); ++it) {
+
+        // unchanged DTO => attributes (incl. values supplied by user) are kept
+        const QByteArray fingerprint = _swaggerModel.definitionFingerprint(it->dtoLabel());
+        if (fingerprint == it->dtoFingerprint())
+            continue;
+
+        const http::dataFlow dtoObjectType =
+            http::httpMethods[it->method().toUpper()]._dtoObjectType;
+        it->setDtoAttributes(_swaggerModel.attributes(it->dtoLabel(), dtoObjectType));
+        it->setDtoFingerprint(fingerprint);
     }
-    return true;
+    return;
+}
+
+// [slot]
+void Session::swaggerPathsIndexed(const SwaggerModel & model) {
+
+    // endpoints get summaries and path parameters before definitions are read
+    _swaggerModel = model;
+    this->applySwaggerOperations();
+
+    return;
+}
+
+// [slot]
+void Session::swaggerLoaded(const SwaggerModel & model) {
+
+    _swaggerModel = model;
+    this->applySwaggerModel();
+
+    emit swaggerLoadingFinished(true, false);
+    return;
+}
+
+// [slot]
+void Session::swaggerNotLoaded(const bool cancelled) {
+
+    emit swaggerLoadingFinished(false, cancelled);
+    return;
 }
 
 bool Session::allValuesSet() const {
@@ -502,6 +648,13 @@ bool Session::prepareRequest(const http::httpMethodType httpMethod, const QStrin
     if (!body.isEmpty())
         newNetworkRequest->setHeader(QNetworkRequest::ContentLengthHeader, body.size());
 
+    // only auxiliary (GET) requests are cached; API requests always go to server
+    const bool useCache =
+        (requestType == ENDPOINTS || requestType == SWAGGER || requestType == SWAGGER_DOC);
+    newNetworkRequest->setAttribute(QNetworkRequest::CacheLoadControlAttribute,
+        (useCache) ? QNetworkRequest::PreferNetwork : QNetworkRequest::AlwaysNetwork);
+    newNetworkRequest->setAttribute(QNetworkRequest::CacheSaveControlAttribute, useCache);
+
     const Request newRequest(*newNetworkRequest, httpMethod, body);
     this->newMessage(newRequest);
 
@@ -543,7 +696,7 @@ bool Session::prepareGetTokenRequest() {
     return requestPrepared;
 }
 
-bool Session::parseTokenReply(uint16_t ID) {
+bool Session::parseTokenReply(quint64 ID) {
 
     Communication * comm = this->findCorrespondingRequest(ID);
     if (comm == nullptr)
@@ -561,6 +714,7 @@ bool Session::parseTokenReply(uint16_t ID) {
 
         comm->setLastReplyContent(replyContent);
         comm->setLastReplyTestStatus();
+        emit messageChanged(_communicationIndex.value(ID));
         fromRes.close();
     }
 
@@ -602,7 +756,7 @@ bool Session::prepareGetEndpointsRequest() {
     return requestPrepared;
 }
 
-bool Session::parseEndpointsReply(uint16_t ID) {
+bool Session::parseEndpointsReply(quint64 ID) {
 
     Communication * comm = this->findCorrespondingRequest(ID);
     if (comm == nullptr)
@@ -620,14 +774,24 @@ bool Session::parseEndpointsReply(uint16_t ID) {
 
         comm->setLastReplyContent(replyContent);
         comm->setLastReplyTestStatus();
+        emit messageChanged(_communicationIndex.value(ID));
         fromRes.close();
     }
 
-    const QJsonDocument endpointsReplyJson = QJsonDocument::fromJson(this->lastReplyContents(ID));
+    const QByteArray replyContents = this->lastReplyContents(ID);
+    const QByteArray sourceHash =
+        QCryptographicHash::hash(replyContents, QCryptographicHash::Sha1);
+
+    // unchanged list (typically revalidated from local cache) => previous parse is kept
+    if (!_endpoints.isEmpty() && sourceHash == _endpointsSourceHash)
+        return true;
+
+    const QJsonDocument endpointsReplyJson = QJsonDocument::fromJson(replyContents);
     if (endpointsReplyJson.isNull())
         return false;
 
-    _endpoints.clear();
+    // list is built aside => on error, current endpoints are kept intact
+    QVector<Endpoint> endpoints;
 
     // whole document
     QJsonObject endpointsObjectJson(endpointsReplyJson.object());
@@ -668,14 +832,44 @@ bool Session::parseEndpointsReply(uint16_t ID) {
                         const QString httpMethod = method["HttpMethod"].toString();
 
                         const Endpoint newEndpoint(name, httpMethod);
-                        this->_endpoints.push_back(newEndpoint);
+                        endpoints.push_back(newEndpoint);
                     }
                 }
             }
         }
     }
 
-    std::sort(_endpoints.begin(), _endpoints.end());
+    std::sort(endpoints.begin(), endpoints.end());
+
+    // endpoints already known (list is sorted) are taken over incl. their Swagger
+    // properties and values supplied by user; only new ones are built from scratch
+    for (QVector<Endpoint>::iterator it = endpoints.begin(); it < endpoints.end(); ++it) {
+
+        QVector<Endpoint>::const_iterator existing =
+            std::lower_bound(_endpoints.constBegin(), _endpoints.constEnd(), *it);
+        if (existing != _endpoints.constEnd() && *existing == *it)
+            *it = *existing;
+    }
+
+    // current endpoint must point into the new list
+    int currentIndex = -1;
+    if (Endpoint::currentEndpoint() != nullptr) {
+
+        const Endpoint & currentEndpoint = *(Endpoint::currentEndpoint());
+        QVector<Endpoint>::const_iterator current =
+            std::lower_bound(endpoints.constBegin(), endpoints.constEnd(), currentEndpoint);
+        if (current != endpoints.constEnd() && *current == currentEndpoint)
+            currentIndex = static_cast<int>(current - endpoints.constBegin());
+    }
+
+    _endpoints.swap(endpoints);
+    Endpoint::setCurrentEndpoint((currentIndex != -1) ? &(_endpoints[currentIndex]) : nullptr);
+
+    // new endpoints get their properties from already loaded Swagger
+    if (!_swaggerModel.isEmpty())
+        this->applySwaggerModel();
+
+    _endpointsSourceHash = sourceHash;
     return true;
 }
 
@@ -712,7 +906,7 @@ bool Session::prepareSwaggerDocsRequest() {
     return requestPrepared;
 }
 
-bool Session::parseSwaggerDocsReply(uint16_t ID, QStringList & swaggerDocsSources) {
+bool Session::parseSwaggerDocsReply(quint64 ID, QStringList & swaggerDocsSources) {
 
     Communication * comm = this->findCorrespondingRequest(ID);
     if (comm == nullptr)
@@ -730,6 +924,7 @@ bool Session::parseSwaggerDocsReply(uint16_t ID, QStringList & swaggerDocsSource
 
         comm->setLastReplyContent(replyContent);
         comm->setLastReplyTestStatus();
+        emit messageChanged(_communicationIndex.value(ID));
         fromRes.close();
     }
 
@@ -757,46 +952,152 @@ bool Session::parseSwaggerDocsReply(uint16_t ID, QStringList & swaggerDocsSource
     return true;
 }
 
-QString Session::selectSource(const QStringList & sourceList) {
+bool Session::downloadSwaggerVersions(const QStringList & sourceList) {
+
+    // previous download (and parsing) of versions is abandoned
+    for (auto it: _swaggerVersionLoaders) {
+        it->cancel();
+        it->deleteLater();
+    }
+    _swaggerVersionLoaders.clear();
+    this->abortSwaggerVersionRequests();
+    _swaggerVersions.clear();
+
+    // user's last choice is kept (if still available)
+    if (!sourceList.contains(_currentSwaggerVersion))
+        _currentSwaggerVersion = sourceList.value(0);
 
-    // get pointer to MainWindow
-    QWidget * const parent = getMainWindowHandle();
+    // all versions are requested at once (over shared network manager), replies are
+    // processed in parseSwaggerVersionReply() as they arrive
+    for (auto it: sourceList) {
 
-     const QString source = QInputDialog::getItem(parent, QStringLiteral("Výběr Swaggeru"),
-         QStringLiteral("Vyberte verzi Swagger dokumentace:"), sourceList, 0, false);
+        const quint64 ID = Communication::_currentID;
 
-     return source;
+        if (!prepareRequest(swaggerDoc.httpMethod, it, swaggerDoc.contentType,
+                            swaggerDoc.accept, SWAGGER_DOC, swaggerDoc.authorizationRequired))
+            continue;
+
+        _swaggerVersionRequests.insert(ID, it);
+        _swaggerVersionReplies.insert(ID, this->sendGetRequestAndWaitForReply());
+    }
+
+    return !(_swaggerVersionRequests.isEmpty());
 }
 
-bool Session::downloadSwaggerFromWeb(const QStringList & sourceList) {
+bool Session::parseSwaggerVersionReply(quint64 ID, QString & version) {
 
-    const QString source =
-        (sourceList.size() > 1) ? this->selectSource(sourceList) : sourceList.at(0);
-    if (source.isNull())
+    // reply to abandoned download
+    if (!_swaggerVersionRequests.contains(ID))
         return false;
 
-    QUrl urlAddress;
-    urlAddress.setScheme(protocols.at(static_cast<int>(this->apiServer()->protocol())));
-    urlAddress.setPort(this->apiServer()->port());
-    urlAddress.setHost(this->apiServer()->hostName(), QUrl::StrictMode);
-    urlAddress.setPath(source, QUrl::StrictMode);
+    version = _swaggerVersionRequests.take(ID);
+    _swaggerVersionReplies.remove(ID);
 
-    QNetworkAccessManager * localManager = new QNetworkAccessManager;
-    QNetworkReply * reply = localManager->get(QNetworkRequest(urlAddress));
+    const Response & reply = this->lastReply(ID);
+    if (reply.statusCode() != OK || reply.response().isEmpty())
+        return false;
 
-    QEventLoop waitForReply;
-    connect(reply, &QNetworkReply::finished, &waitForReply, &QEventLoop::quit);
-    waitForReply.exec();
+    this->loadSwaggerVersion(version, reply.response());
+    return true;
+}
+
+void Session::loadSwaggerVersion(const QString & version, const QByteArray & contents) {
+
+    // versions are parsed concurrently (each on its own worker thread)
+    SwaggerLoader * loader = new SwaggerLoader(this);
+    _swaggerVersionLoaders.insert(version, loader);
+
+    // results of abandoned loaders are ignored
+    connect(loader, &SwaggerLoader::finished, this, [this, version, loader](const SwaggerModel & model)
+            -> void { if (_swaggerVersionLoaders.value(version) == loader)
+                          this->storeSwaggerVersion(version, model); } );
+    connect(loader, &SwaggerLoader::failed, this, [this, version, loader](const bool cancelled)
+            -> void { if (_swaggerVersionLoaders.value(version) == loader)
+                          this->discardSwaggerVersion(version, cancelled); } );
+
+    // only the selected version is reported to user (and applied to endpoints early)
+    const bool isCurrentVersion = (version == _currentSwaggerVersion);
+    if (isCurrentVersion) {
+
+        connect(loader, &SwaggerLoader::progressChanged, this, &Session::swaggerLoadingProgress);
+        connect(loader, &SwaggerLoader::pathsIndexed, this, &Session::swaggerPathsIndexed);
+    }
+
+    loader->start(contents);
+
+    if (isCurrentVersion)
+        emit swaggerLoadingStarted();
+
+    return;
+}
 
-    this->_fileContents = reply->readAll();
-    delete localManager;
+// requests are forgotten first => replies finished by abort() are ignored (see parseSwaggerVersionReply())
+void Session::abortSwaggerVersionRequests() {
 
-    if (_fileContents.isEmpty())
+    const QHash<quint64, QPointer<QNetworkReply>> replies = _swaggerVersionReplies;
+    _swaggerVersionRequests.clear();
+    _swaggerVersionReplies.clear();
+
+    for (const auto & it: replies)
+        if (!it.isNull() && it->isRunning())
+            it->abort();
+
+    return;
+}
+
+bool Session::selectSwaggerVersion(const QString & version) {
+
+    if (!_swaggerVersions.contains(version))
         return false;
 
+    _currentSwaggerVersion = version;
+    _swaggerModel = _swaggerVersions.value(version);
+
+    // only endpoints that differ between versions are rebuilt
+    this->applySwaggerModel();
     return true;
 }
 
+void Session::cancelSwaggerLoading() {
+
+    _swaggerLoader->cancel();
+    for (auto it: _swaggerVersionLoaders)
+        it->cancel();
+    // versions which are still being downloaded would be parsed once they arrive
+    this->abortSwaggerVersionRequests();
+
+    return;
+}
+
+// [slot]
+void Session::storeSwaggerVersion(const QString & version, const SwaggerModel & model) {
+
+    SwaggerLoader * const loader = _swaggerVersionLoaders.take(version);
+    if (loader != nullptr)
+        loader->deleteLater();
+
+    _swaggerVersions.insert(version, model);
+
+    if (version == _currentSwaggerVersion)
+        this->swaggerLoaded(model);
+
+    emit swaggerVersionLoaded(version);
+    return;
+}
+
+// [slot]
+void Session::discardSwaggerVersion(const QString & version, const bool cancelled) {
+
+    SwaggerLoader * const loader = _swaggerVersionLoaders.take(version);
+    if (loader != nullptr)
+        loader->deleteLater();
+
+    if (version == _currentSwaggerVersion)
+        this->swaggerNotLoaded(cancelled);
+
+    return;
+}
+
 void Session::prepareGetRequestQuery(QUrlQuery & query, const QString & path,
                                      const QPair<bool, const QString> & useOwnSelectCondition) {
     // select clause
@@ -820,7 +1121,8 @@ void Session::prepareGetRequestQuery(QUrlQuery & query, const QString & path,
 }
 
 bool Session::prepareGeneralGetRequest(const QString & path, const ContentType & acceptType,
-    const http::httpMethodType httpMethod, const QPair<bool, const QString> & ownSelectClause) {
+    const http::httpMethodType httpMethod, const QPair<bool, const QString> & ownSelectClause,
+    const bool allPages) {
 
     const ContentType contentType = JSON;
     const ContentType accept = acceptType;
@@ -830,8 +1132,28 @@ bool Session::prepareGeneralGetRequest(const QString & path, const ContentType &
     QUrlQuery requestQuery = QUrlQuery();
     prepareGetRequestQuery(requestQuery, path, ownSelectClause);
 
+    const quint64 ID = Communication::_currentID;
     const bool requestPrepared = prepareRequest(httpMethod, path, contentType, accept,
                                                 typeOfRequest, true, QByteArray(), requestQuery);
+
+    // remaining pages are requested when the first one arrives (see fetchRemainingPages())
+    const QRegularExpressionMatch pagedPath = pagedPathRegex.match(path);
+    if (requestPrepared && allPages && httpMethod == http::GET && pagedPath.hasMatch() &&
+        pagedPath.captured(3).toLongLong() > 0) {
+
+        PagedFetch fetch;
+        fetch.firstReply = nullptr;
+        fetch.path = pagedPath.captured(1);
+        fetch.from = pagedPath.captured(2).toLongLong();
+        fetch.count = pagedPath.captured(3).toLongLong();
+        fetch.query = requestQuery;
+        fetch.accept = accept;
+        fetch.nextPage = 1;
+        fetch.pending = 0;
+        fetch.failed = false;
+
+        _pagedFetches.insert(ID, fetch);
+    }
     return requestPrepared;
 }
 
@@ -843,7 +1165,7 @@ bool Session::preparePostRequestBody(QByteArray & body) {
     QString bodyContents;
     const QString quotes = QStringLiteral("\"");
 
-    for (auto it: *(Endpoint::currentEndpoint()->attributes())) {
+    for (auto it: qAsConst(*(Endpoint::currentEndpoint()->attributes()))) {
 
         if (!it.value().toString().isEmpty()) {
 
@@ -933,7 +1255,7 @@ QString Session::testResource(const QNetworkAccessManager::Operation httpMethod,
 }
 
 bool Session::parseReplyToGeneralRequest(
-     uint16_t ID, const QNetworkAccessManager::Operation httpMethod) {
+     quint64 ID, const QNetworkAccessManager::Operation httpMethod) {
 
     Communication * comm = this->findCorrespondingRequest(ID);
     if (comm == nullptr)
@@ -952,15 +1274,24 @@ bool Session::parseReplyToGeneralRequest(
 
         comm->setLastReplyContent(replyContent);
         comm->setLastReplyTestStatus();
+        emit messageChanged(_communicationIndex.value(ID));
         fromRes.close();
     }
 
-    const QJsonDocument replyContentsJson = QJsonDocument::fromJson(this->lastReplyContents(ID));
-    if (replyContentsJson.isNull())
+    const Response & currentResponse = comm->response();
+
+    // body kept in (mapped) file is only scanned => its size is not doubled by DOM
+    if (currentResponse.isFileBacked()) {
+
+        comm->setLastReplyStateAttribs(currentResponse.scanStateAttributes());
+        return true;
+    }
+
+    // body is parsed here once and kept by response (also for ResponseWindow)
+    if (!currentResponse.bodyIsJson())
         return false;
 
     // state attributes
-    Response currentResponse = this->lastReply(ID);
     StateAttributes stateAttribs;
 
     stateAttribs.pageCount = currentResponse.parseBody("PageCount");
@@ -974,27 +1305,181 @@ bool Session::parseReplyToGeneralRequest(
     return true;
 }
 
-void Session::sendGetRequestAndWaitForReply() const {
+// returns true if remaining pages are being fetched (first reply is then kept until all of them arrive)
+bool Session::fetchRemainingPages(quint64 ID) {
+
+    if (!_pagedFetches.contains(ID))
+        return false;
+
+    PagedFetch & fetch = _pagedFetches[ID];
+    const Response & firstPage = this->lastReply(ID);
+
+    // PageCount (and RowCount) describe whole dataset, whereas fetch starts at row "from"
+    // => pages are counted from the rows left (from PageCount if RowCount is missing)
+    bool rowCountRead = false;
+    const qint64 rowCount = firstPage.stateAttributes().rowCount.toLongLong(&rowCountRead);
+    const int pageCount = static_cast<int>((rowCountRead) ?
+        (rowCount - fetch.from + fetch.count - 1) / fetch.count :
+        firstPage.stateAttributes().pageCount.toLongLong() - fetch.from / fetch.count);
+
+    qint64 begin = 0;
+    qint64 end = 0;
+    QVector<QUuid> recordIDs;
+
+    if (firstPage.statusCode() != OK || pageCount <= 1 || !firstPage.locateData(begin, end, recordIDs) ||
+        firstPage.response().at(static_cast<int>(begin)) != '[') {
+
+        this->finishPagedFetch(ID);
+        return false;
+    }
+
+    fetch.pages.resize(pageCount);
+    fetch.pages[0] = firstPage.response().mid(static_cast<int>(begin), static_cast<int>(end - begin));
+
+    // pages are requested concurrently (over shared network manager), but only
+    // a few at a time; next page is requested whenever one of them arrives
+    for (int i = 0; i < maxConcurrentPages && fetch.nextPage < pageCount; ++i)
+        if (!this->sendPageRequest(ID))
+            break;
+
+    // no page has been requested => fetch is reported as incomplete at once
+    if (fetch.pending == 0)
+        this->finishPagedFetch(ID);
+
+    return true;
+}
+
+bool Session::sendPageRequest(const quint64 firstID) {
+
+    PagedFetch & fetch = _pagedFetches[firstID];
 
-    this->_networkManager->get(this->currentRequest());
+    const int page = fetch.nextPage++;
+    const QString path = fetch.path + QStringLiteral("/") +
+                         QString::number(fetch.from + page * fetch.count) +
+                         QStringLiteral("/") + QString::number(fetch.count);
+
+    const quint64 ID = Communication::_currentID;
+    if (!prepareRequest(http::GET, path, JSON, fetch.accept, PAGE, true, QByteArray(), fetch.query)) {
+
+        fetch.failed = true;
+        return false;
+    }
+
+    _pageRequests.insert(ID, qMakePair(firstID, page));
+    ++(fetch.pending);
+    this->sendGetRequestAndWaitForReply();
+
+    return true;
+}
+
+bool Session::parsePageReply(quint64 ID) {
+
+    // reply to abandoned fetch
+    if (!_pageRequests.contains(ID))
+        return false;
+
+    const QPair<quint64, int> page = _pageRequests.take(ID);
+    if (!_pagedFetches.contains(page.first))
+        return false;
+
+    PagedFetch & fetch = _pagedFetches[page.first];
+    --(fetch.pending);
+
+    // data section only (state attributes are taken from first page)
+    const Response & reply = this->lastReply(ID);
+    qint64 begin = 0;
+    qint64 end = 0;
+    QVector<QUuid> recordIDs;
+
+    const bool pageParsed = (reply.statusCode() == OK && reply.locateData(begin, end, recordIDs) &&
+                             reply.response().at(static_cast<int>(begin)) == '[');
+    if (pageParsed) {
+
+        fetch.pages[page.second] = reply.response().mid(static_cast<int>(begin), static_cast<int>(end - begin));
+
+        // empty page => dataset has ended (pages which have not been requested are not needed)
+        if (fetch.pages.at(page.second).mid(1).chopped(1).trimmed().isEmpty())
+            fetch.nextPage = fetch.pages.size();
+    }
+    else
+        fetch.failed = true;
+
+    if (!fetch.failed && fetch.nextPage < fetch.pages.size())
+        this->sendPageRequest(page.first);
+
+    if (fetch.pending == 0)
+        this->finishPagedFetch(page.first);
+
+    return pageParsed;
+}
+
+void Session::finishPagedFetch(const quint64 ID) {
+
+    PagedFetch fetch = _pagedFetches.take(ID);
+    const bool complete = (!fetch.failed && fetch.nextPage >= fetch.pages.size());
+
+    // data sections (arrays) of all pages are merged (in order) into body of first reply
+    if (complete && fetch.pages.size() > 1) {
+
+        Communication * comm = this->findCorrespondingRequest(ID);
+        const QByteArray firstPage = comm->response().response();
+
+        qint64 begin = 0;
+        qint64 end = 0;
+        QVector<QUuid> recordIDs;
+        comm->response().locateData(begin, end, recordIDs);
+
+        QByteArray data;
+        for (auto it: qAsConst(fetch.pages)) {
+
+            // page not requested (dataset ended earlier)
+            if (it.isEmpty())
+                continue;
+            const QByteArray elements = it.trimmed().mid(1).chopped(1).trimmed();
+            if (elements.isEmpty())
+                continue;
+            if (!data.isEmpty())
+                data.append(',');
+            data.append(elements);
+        }
+
+        comm->setLastReplyContent(firstPage.left(static_cast<int>(begin)) + '[' + data + ']' +
+                                  firstPage.mid(static_cast<int>(end)));
+        emit messageChanged(_communicationIndex.value(ID));
+    }
+
+    if (fetch.firstReply != nullptr) {
+
+        if (fetch.pages.size() > 1)
+            emit allPagesFetched(fetch.firstReply, complete);
+        fetch.firstReply->deleteLater();
+    }
     return;
 }
 
+QNetworkReply * Session::sendGetRequestAndWaitForReply() const {
+
+    // body is read as it arrives (large body is moved to temporary file)
+    QNetworkReply * const reply = this->_networkManager->get(this->currentRequest());
+    new ReplyBuffer(reply);
+    return reply;
+}
+
 void Session::sendPostRequestAndWaitForReply() const {
 
-    this->_networkManager->post(this->currentRequest(), this->currentRequestBody());
+    new ReplyBuffer(this->_networkManager->post(this->currentRequest(), this->currentRequestBody()));
     return;
 }
 
 void Session::sendPutRequestAndWaitForReply() const {
 
-    this->_networkManager->put(this->currentRequest(), this->currentRequestBody());
+    new ReplyBuffer(this->_networkManager->put(this->currentRequest(), this->currentRequestBody()));
     return;
 }
 
 void Session::sendDeleteRequestAndWaitForReply() const {
 
-    this->_networkManager->deleteResource(this->currentRequest());
+    new ReplyBuffer(this->_networkManager->deleteResource(this->currentRequest()));
     return;
 }
 
@@ -1004,8 +1489,31 @@ void Session::replyFinished(QNetworkReply * const reply) {
     bool replySuccessfullySet = this->setReplyToCurrentRequest(reply);
 
     reply->close();
+
+    // first page is shown (see ResponseWindow) only when all pages have arrived
+    const quint64 ID = reply->request().attribute(Request::userAttribute(1)).toULongLong();
+    if (_pagedFetches.contains(ID) && _pagedFetches[ID].firstReply == nullptr) {
+
+        _pagedFetches[ID].firstReply = reply;
+        return;
+    }
+
     reply->deleteLater();
 
     return;
 }
 
+// [slot]
+void Session::accountChangedMessage(const int position) {
+
+    if (position < 0 || position >= _communication.size())
+        return;
+
+    // reply of older message (e.g. page) may replace its already compressed body
+    _firstUncompressed = qMin(_firstUncompressed, position);
+    _firstUnarchived = qMin(_firstUnarchived, position);
+
+    this->updateHistoryUsage(position);
+    this->enforceHistoryBudget();
+    return;
+}
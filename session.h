@@ -6,9 +6,12 @@
 #ifndef SESSION_H
 #define SESSION_H
 
+#include <QHash>
+#include <QMap>
 #include <QNetworkAccessManager>
 #include <QObject>
 #include <QPair>
+#include <QPointer>
 #include <QUrlQuery>
 #include <QWidget>
 #include "connection.h"
@@ -16,8 +19,27 @@
 #include "database.h"
 #include "endpoint.h"
 #include "error.h"
+#include "journal.h"
 #include "methods.h"
 #include "request.h"
+#include "swaggerloader.h"
+#include "swaggermodel.h"
+
+// GET request whose remaining pages are fetched automatically (see Session::fetchRemainingPages());
+// paged path ends with /{from}/{count}
+struct PagedFetch {
+
+    QNetworkReply * firstReply;
+    QString path; // without /{from}/{count}
+    qint64 from;
+    qint64 count;
+    QUrlQuery query;
+    ContentType accept;
+    int nextPage;
+    int pending;
+    bool failed;
+    QVector<QByteArray> pages; // Data section of every page (first reply incl.)
+};
 
 class Session: public QObject {
 
@@ -31,8 +53,14 @@ class Session: public QObject {
 
         const static QString jsonFileType;
         const static QRegularExpression swaggerUrlsRegex;
+        const static QRegularExpression pagedPathRegex;
+        const static int maxConcurrentPages;
+        const static int uncompressedHistoryEntries;
 
         inline QVector<Endpoint> * endpoints() { return &(_endpoints); }
+        inline const SwaggerModel & swaggerModel() const { return _swaggerModel; }
+        inline QStringList swaggerVersions() const { return _swaggerVersions.keys(); }
+        inline QString currentSwaggerVersion() const { return _currentSwaggerVersion; }
         inline Token * token() const { return _accessToken; }
         inline ConnectionS5 * connectionSettings() const { return _connectionSettings; }
         inline ConnectionApi * apiServer() const { return _apiServer; }
@@ -44,6 +72,7 @@ class Session: public QObject {
         inline QString configFileLastDir() const { return _configFileLastDir; }
         inline QString swaggerFileLastDir() const { return _swaggerFileLastDir; }
         inline QVector<Communication> & communication() { return _communication; }
+        inline Journal * journal() const { return _journal; }
         inline bool inTestMode() const { return _testModeEnabled; }
 
         inline void setFileName(const QString & fileName) {
@@ -57,6 +86,8 @@ class Session: public QObject {
         inline void setAndApplyProxy(const bool useProxy)
             { _useProxy = useProxy; setupProxy(_useProxy); return; }
         inline void setTestMode(const bool inTestMode) { _testModeEnabled = inTestMode; return; }
+        inline void setHistoryMemoryBudget(const qint64 budget)
+            { _historyMemoryBudget = budget; enforceHistoryBudget(); return; }
 
         void newMessage(const Request &);
         QNetworkRequest currentRequest() const;
@@ -64,16 +95,16 @@ class Session: public QObject {
 
         inline static StatusCode getStatus(const QNetworkReply * const reply)
             { return (static_cast<StatusCode>(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt())); }
-        inline Response lastReply(const uint16_t);
-        inline QByteArray lastReplyContents(const uint16_t);
+        inline const Response & lastReply(const quint64);
+        inline QByteArray lastReplyContents(const quint64);
 
         inline err::fileError openFile(const Session * const session)
             { return (openFile(session->_fileName)); }
         err::fileError openFile(const QString &);
 
-        Communication * findCorrespondingRequest(const uint16_t);
+        Communication * findCorrespondingRequest(const quint64);
         QString getTableName(const QVariant &);
-        State verifyTableRecords(const QString &, const QList<QString> &,
+        State verifyTableRecords(const QString &, const QVector<QUuid> &,
                                  const QNetworkAccessManager::Operation &);
 
         bool allValuesSet() const;
@@ -82,6 +113,10 @@ class Session: public QObject {
 
         bool parseConfigFile();
         bool parseSwaggerFile();
+        bool loadSwaggerFile();
+        inline bool swaggerIsLoading() const
+            { return (_swaggerLoader->isRunning() || !_swaggerVersionLoaders.isEmpty()); }
+        void cancelSwaggerLoading();
 
         bool prepareRequest(const http::httpMethodType, const QString &, const ContentType &,
                             const ContentType &, const RequestType &, bool = false,
@@ -89,30 +124,38 @@ class Session: public QObject {
         bool prepareTestConnectionRequest();
 
         bool prepareGetTokenRequest();
-        bool parseTokenReply(uint16_t);
+        bool parseTokenReply(quint64);
         void setTokenData(const QString &, const QString &, const int);
 
         bool prepareGetEndpointsRequest();
-        bool parseEndpointsReply(uint16_t);
+        bool parseEndpointsReply(quint64);
         bool downloadListOfEndpoints();
 
         bool prepareSwaggerDocsRequest();
-        bool parseSwaggerDocsReply(uint16_t, QStringList &);
-        bool downloadSwaggerFromWeb(const QStringList &);
+        bool parseSwaggerDocsReply(quint64, QStringList &);
+        bool downloadSwaggerVersions(const QStringList &);
+        bool parseSwaggerVersionReply(quint64, QString &);
+        bool selectSwaggerVersion(const QString &);
 
         void prepareGetRequestQuery(QUrlQuery &, const QString &,
                                     const QPair<bool, const QString> & = { false, QString() });
         bool prepareGeneralGetRequest(const QString &, const ContentType &,
                                       const http::httpMethodType = http::GET,
-                                      const QPair<bool, const QString> & = { false, QString() });
+                                      const QPair<bool, const QString> & = { false, QString() },
+                                      const bool = false);
         bool preparePostRequestBody(QByteArray &);
         bool prepareGeneralPostRequest(const QString &, const ContentType &,
                                        const http::httpMethodType = http::POST);
         bool prepareGeneralPutRequest(const QString &, const ContentType &);
         bool prepareGeneralDeleteRequest(const QString &, const ContentType &);
-        bool parseReplyToGeneralRequest(uint16_t, const QNetworkAccessManager::Operation);
+        bool parseReplyToGeneralRequest(quint64, const QNetworkAccessManager::Operation);
+        bool fetchRemainingPages(quint64);
+        bool parsePageReply(quint64);
+
+        // see also ReplayEngine
+        bool setAuthorizationHeader(QNetworkRequest * const);
 
-        void sendGetRequestAndWaitForReply() const;
+        QNetworkReply * sendGetRequestAndWaitForReply() const;
         void sendPostRequestAndWaitForReply() const;
         void sendPutRequestAndWaitForReply() const;
         void sendDeleteRequestAndWaitForReply() const;
@@ -122,12 +165,28 @@ class Session: public QObject {
     private:
         QWidget * getMainWindowHandle() const;
         QString testResource(const QNetworkAccessManager::Operation, const bool = true) const;
-        bool setAuthorizationHeader(QNetworkRequest * const);
         bool setReplyToCurrentRequest(QNetworkReply * const);
-        QString selectSource(const QStringList &);
+        void loadSwaggerVersion(const QString &, const QByteArray &);
+        void abortSwaggerVersionRequests();
+        bool sendPageRequest(const quint64);
+        void finishPagedFetch(const quint64);
+        void applySwaggerModel();
+        void applySwaggerOperations();
+        void applySwaggerDefinitions();
         void setupProxy(const bool);
+        void updateHistoryUsage(const int);
+        void enforceHistoryBudget();
 
         QVector<Endpoint> _endpoints;
+        SwaggerModel _swaggerModel;
+        SwaggerLoader * _swaggerLoader;
+        QMap<QString, SwaggerModel> _swaggerVersions;
+        QMap<QString, SwaggerLoader *> _swaggerVersionLoaders;
+        QHash<quint64, QString> _swaggerVersionRequests;
+        QHash<quint64, QPointer<QNetworkReply>> _swaggerVersionReplies; // replies still in flight
+        QString _currentSwaggerVersion;
+        QHash<quint64, PagedFetch> _pagedFetches;
+        QHash<quint64, QPair<quint64, int>> _pageRequests; // page's ID => (ID of first page, page)
         Token * _accessToken;
         ConnectionS5 * _connectionSettings;
         ConnectionApi * _apiServer;
@@ -137,14 +196,39 @@ class Session: public QObject {
         QString _fileName;
         QString _webSourceUrl;
         QByteArray _fileContents;
+        QByteArray _endpointsSourceHash;
         QString _configFileLastDir;
         QString _swaggerFileLastDir;
         QVector<Communication> _communication;
+        QHash<quint64, int> _communicationIndex; // message ID => position in _communication
+        qint64 _historyMemoryBudget;
+        qint64 _historyMemoryUsage; // sum of _historyEntryUsage
+        QVector<qint64> _historyEntryUsage; // memory usage of message when last accounted
+        int _firstUncompressed; // messages before are compressed (or archived)
+        int _firstUnarchived; // messages before are archived
+        QSharedPointer<HistoryArchive> _historyArchive;
+        Journal * _journal;
         bool _useProxy;
         bool _testModeEnabled;
 
+    signals:
+        void swaggerLoadingStarted() const;
+        void swaggerLoadingProgress(const int) const;
+        void swaggerLoadingFinished(const bool, const bool) const;
+        void swaggerVersionLoaded(const QString &) const;
+        void allPagesFetched(const QNetworkReply * const, const bool) const;
+        // position of message in communication() (see CommunicationModel)
+        void messageAdded(const int) const;
+        void messageChanged(const int) const;
+
     private slots:
         void replyFinished(QNetworkReply *);
+        void swaggerPathsIndexed(const SwaggerModel &);
+        void swaggerLoaded(const SwaggerModel &);
+        void storeSwaggerVersion(const QString &, const SwaggerModel &);
+        void swaggerNotLoaded(const bool);
+        void discardSwaggerVersion(const QString &, const bool);
+        void accountChangedMessage(const int);
 };
 
 #endif // SESSION_H
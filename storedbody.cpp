@@ -0,0 +1,96 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QDir>
+#include "storedbody.h"
+
+const int StoredBody::minCompressedSize = 256;
+
+HistoryArchive::HistoryArchive():
+    _file(QDir::tempPath() + QStringLiteral("/TAPI_history_XXXXXX.archive")) {
+
+    _file.open();
+}
+
+// returns offset of stored data (-1 on failure)
+qint64 HistoryArchive::append(const QByteArray & data) {
+
+    if (!_file.isOpen() || !_file.seek(_file.size()))
+        return -1;
+
+    const qint64 offset = _file.pos();
+    if (_file.write(data) != data.size()) {
+
+        // partially written data are dropped
+        _file.resize(offset);
+        return -1;
+    }
+    return offset;
+}
+
+QByteArray HistoryArchive::read(const qint64 offset, const int length) {
+
+    if (!_file.isOpen() || !_file.seek(offset))
+        return QByteArray();
+
+    return _file.read(length);
+}
+
+QByteArray StoredBody::data(bool * const ok) const {
+
+    if (ok != nullptr)
+        *ok = true;
+    if (_state == PLAIN)
+        return _data;
+
+    // archive may have been truncated or it may not be readable at all
+    const QByteArray compressed = (_state == ARCHIVED) ? _archive->read(_offset, _length) : _data;
+    if (compressed.size() == _length || _state == COMPRESSED) {
+
+        const QByteArray contents = qUncompress(compressed);
+        if (contents.size() == _size)
+            return contents;
+    }
+
+    if (ok != nullptr)
+        *ok = false;
+    return QByteArray();
+}
+
+bool StoredBody::compress() {
+
+    if (_state != PLAIN || _size < minCompressedSize)
+        return false;
+
+    // incompressible contents (e.g. binary data) are kept as they are
+    const QByteArray compressed = qCompress(_data);
+    if (compressed.size() >= _size)
+        return false;
+
+    _data = compressed;
+    _state = COMPRESSED;
+
+    return true;
+}
+
+bool StoredBody::archive(const QSharedPointer<HistoryArchive> & archive) {
+
+    if (_state == ARCHIVED || _size == 0 || archive.isNull())
+        return false;
+
+    // archive contains compressed data only
+    const QByteArray compressed = (_state == PLAIN) ? qCompress(_data) : _data;
+    const qint64 offset = archive->append(compressed);
+    if (offset < 0)
+        return false;
+
+    _archive = archive;
+    _offset = offset;
+    _length = compressed.size();
+    _data = QByteArray();
+    _state = ARCHIVED;
+
+    return true;
+}
@@ -0,0 +1,63 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef STOREDBODY_H
+#define STOREDBODY_H
+
+#include <QByteArray>
+#include <QSharedPointer>
+#include <QTemporaryFile>
+
+// append-only file of bodies evicted from communication history
+class HistoryArchive {
+
+    public:
+        HistoryArchive();
+        ~HistoryArchive() {}
+
+        inline bool isOpen() const { return _file.isOpen(); }
+
+        qint64 append(const QByteArray &);
+        QByteArray read(const qint64, const int);
+
+    private:
+        QTemporaryFile _file;
+};
+
+// body of request or response kept in history: plain, compressed (qCompress)
+// or archived on disk; data() always returns original (decompressed) contents
+// or empty array with ok set to false if they cannot be restored
+class StoredBody {
+
+    public:
+        enum State { PLAIN = 0, COMPRESSED = 1, ARCHIVED = 2 };
+
+        // smaller bodies are not worth compressing
+        const static int minCompressedSize;
+
+        StoredBody(): _state(PLAIN), _size(0), _offset(-1), _length(0) {}
+        StoredBody(const QByteArray & data):
+            _state(PLAIN), _data(data), _size(data.size()), _offset(-1), _length(0) {}
+        ~StoredBody() {}
+
+        inline State state() const { return _state; }
+        inline int size() const { return _size; }
+        inline bool isEmpty() const { return (_size == 0); }
+        inline qint64 memoryUsage() const { return _data.size(); }
+
+        QByteArray data(bool * const = nullptr) const;
+        bool compress();
+        bool archive(const QSharedPointer<HistoryArchive> &);
+
+    private:
+        State _state;
+        QByteArray _data; // plain or compressed contents (empty if archived)
+        int _size;        // size of original contents
+        QSharedPointer<HistoryArchive> _archive;
+        qint64 _offset;
+        int _length;      // size of compressed contents in archive
+};
+
+#endif // STOREDBODY_H
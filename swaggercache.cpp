@@ -0,0 +1,91 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include "swaggercache.h"
+
+const quint32 SwaggerCache::magicNumber = 0x54415053; // "TAPS"
+// 2: fingerprints of operations and definitions are stored
+const quint16 SwaggerCache::formatVersion = 2;
+
+SwaggerCache::SwaggerCache():
+    _directory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+               QStringLiteral("/swagger")) {}
+
+QByteArray SwaggerCache::sourceHash(const QByteArray & source) {
+
+    return QCryptographicHash::hash(source, QCryptographicHash::Sha1);
+}
+
+QString SwaggerCache::fileName(const QByteArray & hash) const {
+
+    return _directory + QStringLiteral("/") + QString::fromLatin1(hash.toHex()) +
+           QStringLiteral(".tapis");
+}
+
+bool SwaggerCache::load(const QByteArray & hash, SwaggerModel & model) const {
+
+    QFile file(this->fileName(hash));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 size = file.size();
+    uchar * const mappedFile = file.map(0, size);
+    if (mappedFile == nullptr)
+        return false;
+
+    // whole snapshot is read directly from mapped memory (no intermediate copy)
+    const QByteArray contents =
+        QByteArray::fromRawData(reinterpret_cast<const char *>(mappedFile), static_cast<int>(size));
+    QDataStream in(contents);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    QByteArray storedHash;
+    in >> magic >> version >> storedHash;
+
+    bool snapshotLoaded = false;
+    if (magic == magicNumber && version == formatVersion && storedHash == hash) {
+
+        in >> model;
+        snapshotLoaded = (in.status() == QDataStream::Ok && !model.isEmpty());
+    }
+
+    file.unmap(mappedFile);
+    file.close();
+
+    if (!snapshotLoaded)
+        model.clear();
+
+    return snapshotLoaded;
+}
+
+bool SwaggerCache::store(const QByteArray & hash, const SwaggerModel & model) const {
+
+    if (!QDir().mkpath(_directory))
+        return false;
+
+    // snapshot is either written completely or not at all
+    QSaveFile file(this->fileName(hash));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << magicNumber << formatVersion << hash << model;
+
+    if (out.status() != QDataStream::Ok) {
+
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
@@ -0,0 +1,36 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef SWAGGERCACHE_H
+#define SWAGGERCACHE_H
+
+#include <QByteArray>
+#include <QString>
+#include "swaggermodel.h"
+
+// compiled (binary) snapshots of parsed Swagger documents keyed by hash of the source
+class SwaggerCache {
+
+    public:
+        SwaggerCache();
+        ~SwaggerCache() {}
+
+        const static quint32 magicNumber;
+        const static quint16 formatVersion;
+
+        static QByteArray sourceHash(const QByteArray &);
+
+        inline QString directory() const { return _directory; }
+
+        bool load(const QByteArray &, SwaggerModel &) const;
+        bool store(const QByteArray &, const SwaggerModel &) const;
+
+    private:
+        QString fileName(const QByteArray &) const;
+
+        QString _directory;
+};
+
+#endif // SWAGGERCACHE_H
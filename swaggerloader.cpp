@@ -0,0 +1,135 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QtConcurrent>
+#include "swaggerloader.h"
+#include "swaggerreader.h"
+
+SwaggerLoader::SwaggerLoader(QObject * parent): QObject(parent),
+    _watcher(new QFutureWatcher<SwaggerLoadResult>(this)), _cancelled(0), _generation(0) {
+
+    qRegisterMetaType<SwaggerModel>();
+
+    connect(this, &SwaggerLoader::pathsIndexedInBackground,
+            this, &SwaggerLoader::forwardIndexedPaths, Qt::QueuedConnection);
+    connect(_watcher, &QFutureWatcher<SwaggerLoadResult>::finished,
+            this, &SwaggerLoader::processResult);
+}
+
+SwaggerLoader::~SwaggerLoader() {
+
+    // worker thread uses this object => it must not outlive it
+    this->cancel();
+    _watcher->waitForFinished();
+}
+
+bool SwaggerLoader::load(const QByteArray & contents, SwaggerModel & model) {
+
+    // compiled snapshot of the very same document is preferred to parsing
+    const SwaggerCache cache;
+    const QByteArray sourceHash = SwaggerCache::sourceHash(contents);
+
+    if (cache.load(sourceHash, model))
+        return true;
+
+    // index paths, operations and definitions (once per document, no DOM is built)
+    SwaggerReader reader(contents);
+    if (!reader.read(model))
+        return false;
+
+    cache.store(sourceHash, model);
+    return true;
+}
+
+void SwaggerLoader::start(const QByteArray & contents) {
+
+    // previous (unfinished) loading is abandoned
+    if (_watcher->isRunning()) {
+
+        this->cancel();
+        _watcher->waitForFinished();
+    }
+
+    _cancelled.storeRelease(0);
+    ++_generation;
+
+    _watcher->setFuture(QtConcurrent::run(this, &SwaggerLoader::loadInBackground,
+                                          contents, _generation));
+    return;
+}
+
+void SwaggerLoader::cancel() {
+
+    _cancelled.storeRelease(1);
+    return;
+}
+
+// [worker thread]
+SwaggerLoadResult SwaggerLoader::loadInBackground(const QByteArray contents, const int generation) {
+
+    SwaggerLoadResult result = { false, false, SwaggerModel() };
+
+    const QByteArray sourceHash = SwaggerCache::sourceHash(contents);
+    if (_cache.load(sourceHash, result.model)) {
+
+        result.loaded = true;
+        return result;
+    }
+
+    SwaggerReader reader(contents);
+    int lastPercentage = -1;
+
+    reader.setProgressHandler([this, &lastPercentage]
+        (const qint64 bytesRead, const qint64 bytesTotal) -> bool {
+
+        const int percentage =
+            (bytesTotal > 0) ? static_cast<int>((100 * bytesRead) / bytesTotal) : 0;
+        if (percentage != lastPercentage) {
+
+            lastPercentage = percentage;
+            emit progressChanged(percentage);
+        }
+        return (_cancelled.loadAcquire() == 0);
+    });
+    reader.setPathsIndexedHandler([this, generation](const SwaggerModel & model) -> void
+        { emit pathsIndexedInBackground(generation, model); });
+
+    result.loaded = reader.read(result.model);
+    result.cancelled = reader.wasCancelled();
+
+    if (result.loaded)
+        _cache.store(sourceHash, result.model);
+
+    return result;
+}
+
+// [slot]
+void SwaggerLoader::forwardIndexedPaths(const int generation, const SwaggerModel & model) const {
+
+    // paths of abandoned loading are ignored
+    if (generation == _generation && _watcher->isRunning())
+        emit pathsIndexed(model);
+
+    return;
+}
+
+// [slot]
+void SwaggerLoader::processResult() const {
+
+    if (!_watcher->isFinished() || _watcher->isCanceled())
+        return;
+
+    const SwaggerLoadResult result = _watcher->result();
+
+    if (result.loaded) {
+
+        emit progressChanged(100);
+        emit finished(result.model);
+    }
+    else
+        emit failed(result.cancelled);
+
+    return;
+}
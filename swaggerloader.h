@@ -0,0 +1,62 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef SWAGGERLOADER_H
+#define SWAGGERLOADER_H
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QFutureWatcher>
+#include <QObject>
+#include "swaggercache.h"
+#include "swaggermodel.h"
+
+struct SwaggerLoadResult {
+
+    bool loaded;
+    bool cancelled;
+    SwaggerModel model;
+};
+
+// loads (compiled snapshot or streaming parse) Swagger documents on a worker thread;
+// the complete model is handed over to the GUI thread in finished() signal
+class SwaggerLoader: public QObject {
+
+    Q_OBJECT
+
+    public:
+        explicit SwaggerLoader(QObject * = nullptr);
+        ~SwaggerLoader();
+
+        static bool load(const QByteArray &, SwaggerModel &);
+
+        inline bool isRunning() const { return _watcher->isRunning(); }
+
+        void start(const QByteArray &);
+        void cancel();
+
+    signals:
+        void progressChanged(const int) const;
+        void pathsIndexed(const SwaggerModel &) const;
+        void finished(const SwaggerModel &) const;
+        void failed(const bool) const;
+
+        // emitted from worker thread (queued to GUI thread)
+        void pathsIndexedInBackground(const int, const SwaggerModel &) const;
+
+    private:
+        SwaggerLoadResult loadInBackground(const QByteArray, const int);
+
+        SwaggerCache _cache;
+        QFutureWatcher<SwaggerLoadResult> * _watcher;
+        QAtomicInt _cancelled;
+        int _generation;
+
+    private slots:
+        void forwardIndexedPaths(const int, const SwaggerModel &) const;
+        void processResult() const;
+};
+
+#endif // SWAGGERLOADER_H
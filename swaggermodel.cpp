@@ -0,0 +1,153 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QCryptographicHash>
+#include "swaggermodel.h"
+
+QString SwaggerOperation::dtoLabel(const http::dataFlow flow) const {
+
+    switch (flow) {
+
+        case http::INPUT: return _inputDtoLabel;
+        case http::OUTPUT: return _outputDtoLabel;
+        default: return QString();
+    }
+
+    return QString();
+}
+
+void SwaggerOperation::writeFields(QDataStream & out) const {
+
+    out << _summary << static_cast<quint32>(_parameters.size());
+    for (auto it: _parameters)
+        out << it.name() << it.required() << it.type();
+    out << _inputDtoLabel << _outputDtoLabel;
+
+    return;
+}
+
+QByteArray SwaggerOperation::computeFingerprint() const {
+
+    // everything an endpoint takes over from operation (summary, params, DTO labels)
+    QByteArray serializedOperation;
+    QDataStream out(&serializedOperation, QIODevice::WriteOnly);
+    this->writeFields(out);
+
+    return QCryptographicHash::hash(serializedOperation, QCryptographicHash::Sha1);
+}
+
+QString SwaggerModel::makeType(const QString & type, const QString & format) {
+
+    QString delimiter = QStringLiteral("/");
+
+    if (type.isEmpty() || format.isEmpty())
+        delimiter.clear();
+
+    return (type + delimiter + format);
+}
+
+QString SwaggerModel::dtoLabelFromReference(const QString & dtoLink) {
+
+    // #/definitions/<label>
+    return dtoLink.right(dtoLink.length() - dtoLink.lastIndexOf('/') - 1);
+}
+
+void SwaggerModel::addOperation(const QString & path, const QString & method,
+                                const SwaggerOperation & operation) {
+
+    _operations[path].insert(method.toLower(), operation);
+    return;
+}
+
+void SwaggerModel::addDefinition(const QString & dtoLabel,
+                                 const QVector<QPair<QString, QString>> & properties) {
+
+    _definitions.insert(dtoLabel, properties);
+
+    QByteArray serializedDefinition;
+    QDataStream out(&serializedDefinition, QIODevice::WriteOnly);
+    out << dtoLabel << properties;
+    _definitionFingerprints.insert(dtoLabel,
+                                   QCryptographicHash::hash(serializedDefinition, QCryptographicHash::Sha1));
+    return;
+}
+
+void SwaggerModel::clear() {
+
+    _operations.clear();
+    _definitions.clear();
+    _definitionFingerprints.clear();
+    _resolvedDtos.clear();
+
+    return;
+}
+
+SwaggerOperation SwaggerModel::operation(const QString & path, const QString & method) const {
+
+    return _operations.value(path).value(method.toLower());
+}
+
+QVector<Attributes> SwaggerModel::attributes(const QString & dtoLabel, const http::dataFlow flow) {
+
+    if (dtoLabel.isEmpty() || !_definitions.contains(dtoLabel))
+        return QVector<Attributes>();
+
+    // every DTO is resolved only once; endpoints sharing a DTO share its (implicitly shared) list
+    const QPair<QString, int> key(dtoLabel, static_cast<int>(flow));
+    QHash<QPair<QString, int>, QVector<Attributes>>::const_iterator it = _resolvedDtos.constFind(key);
+    if (it != _resolvedDtos.constEnd())
+        return it.value();
+
+    const QVector<QPair<QString, QString>> & properties = _definitions[dtoLabel];
+    QVector<Attributes> dtoAttributes;
+    dtoAttributes.reserve(properties.size());
+
+    for (auto it_property: properties)
+        dtoAttributes.push_back(Attributes(it_property.first, it_property.second, flow));
+
+    _resolvedDtos.insert(key, dtoAttributes);
+    return dtoAttributes;
+}
+
+QDataStream & operator<<(QDataStream & out, const SwaggerOperation & operation) {
+
+    operation.writeFields(out);
+    out << operation._fingerprint;
+
+    return out;
+}
+
+QDataStream & operator>>(QDataStream & in, SwaggerOperation & operation) {
+
+    quint32 noOfParams = 0;
+    in >> operation._summary >> noOfParams;
+
+    // Parameters has no default constructor => cannot be streamed as a container
+    operation._parameters.clear();
+    for (quint32 i = 0; i < noOfParams && in.status() == QDataStream::Ok; ++i) {
+
+        QString name, type;
+        bool required = false;
+        in >> name >> required >> type;
+        operation._parameters.push_back(Parameters(name, required, type));
+    }
+    in >> operation._inputDtoLabel >> operation._outputDtoLabel >> operation._fingerprint;
+
+    return in;
+}
+
+QDataStream & operator<<(QDataStream & out, const SwaggerModel & model) {
+
+    out << model._operations << model._definitions << model._definitionFingerprints;
+    return out;
+}
+
+QDataStream & operator>>(QDataStream & in, SwaggerModel & model) {
+
+    model.clear();
+    in >> model._operations >> model._definitions >> model._definitionFingerprints;
+
+    return in;
+}
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef SWAGGERMODEL_H
+#define SWAGGERMODEL_H
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QHash>
+#include <QMetaType>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include "endpoint.h"
+#include "methods.h"
+
+class SwaggerOperation {
+
+    public:
+        // missing operation has no fingerprint (endpoint which had one is reset)
+        SwaggerOperation() {}
+        SwaggerOperation(const QString & summary, const QVector<Parameters> & parameters,
+                         const QString & inputDtoLabel, const QString & outputDtoLabel):
+            _summary(summary), _parameters(parameters),
+            _inputDtoLabel(inputDtoLabel), _outputDtoLabel(outputDtoLabel)
+            { _fingerprint = this->computeFingerprint(); }
+        ~SwaggerOperation() {}
+
+        inline QString summary() const { return _summary; }
+        inline const QVector<Parameters> & parameters() const { return _parameters; }
+        inline QString inputDtoLabel() const { return _inputDtoLabel; }
+        inline QString outputDtoLabel() const { return _outputDtoLabel; }
+        QString dtoLabel(const http::dataFlow) const;
+        // computed once when operation is built (stored in snapshot, see SwaggerCache)
+        inline QByteArray fingerprint() const { return _fingerprint; }
+
+        friend QDataStream & operator<<(QDataStream &, const SwaggerOperation &);
+        friend QDataStream & operator>>(QDataStream &, SwaggerOperation &);
+
+    private:
+        void writeFields(QDataStream &) const;
+        QByteArray computeFingerprint() const;
+
+        QString _summary;
+        QVector<Parameters> _parameters; // all parameters (path, query, body)
+        QString _inputDtoLabel;
+        QString _outputDtoLabel;
+        QByteArray _fingerprint;
+};
+
+QDataStream & operator<<(QDataStream &, const SwaggerOperation &);
+QDataStream & operator>>(QDataStream &, SwaggerOperation &);
+
+class SwaggerModel {
+
+    public:
+        SwaggerModel() {}
+        ~SwaggerModel() {}
+
+        static QString makeType(const QString &, const QString &);
+        static QString dtoLabelFromReference(const QString &);
+
+        void addOperation(const QString &, const QString &, const SwaggerOperation &);
+        void addDefinition(const QString &, const QVector<QPair<QString, QString>> &);
+        void clear();
+
+        inline bool isEmpty() const { return _operations.isEmpty(); }
+        inline int noOfPaths() const { return _operations.size(); }
+        inline int noOfDefinitions() const { return _definitions.size(); }
+
+        SwaggerOperation operation(const QString &, const QString &) const;
+        QVector<Attributes> attributes(const QString &, const http::dataFlow);
+        inline QByteArray definitionFingerprint(const QString & dtoLabel) const
+            { return _definitionFingerprints.value(dtoLabel); }
+
+        friend QDataStream & operator<<(QDataStream &, const SwaggerModel &);
+        friend QDataStream & operator>>(QDataStream &, SwaggerModel &);
+
+    private:
+        // key: path, value: { key: http method (lowercase), value: operation }
+        QHash<QString, QHash<QString, SwaggerOperation>> _operations;
+        // key: DTO label, value: list of { attribute name, data type }
+        QHash<QString, QVector<QPair<QString, QString>>> _definitions;
+        // key: DTO label, value: fingerprint computed when definition is added
+        QHash<QString, QByteArray> _definitionFingerprints;
+        // key: { DTO label, data flow }, value: attributes resolved on first use
+        QHash<QPair<QString, int>, QVector<Attributes>> _resolvedDtos;
+};
+
+QDataStream & operator<<(QDataStream &, const SwaggerModel &);
+QDataStream & operator>>(QDataStream &, SwaggerModel &);
+
+Q_DECLARE_METATYPE(SwaggerModel)
+
+#endif // SWAGGERMODEL_H
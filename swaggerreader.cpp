@@ -0,0 +1,319 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QStringList>
+#include <algorithm>
+#include "swaggerreader.h"
+
+SwaggerReader::SwaggerReader(const QByteArray & contents):
+    _scanner(contents), _cancelled(false) {}
+
+bool SwaggerReader::reportProgress() {
+
+    if (_progressHandler && !_progressHandler(_scanner.position(), _scanner.size())) {
+
+        // stops all nested loops at once
+        _cancelled = true;
+        _scanner.abort();
+    }
+    return !_cancelled;
+}
+
+bool SwaggerReader::read(SwaggerModel & model) {
+
+    model.clear();
+
+    bool pathsFound = false;
+    bool definitionsFound = false;
+
+    if (!_scanner.enterObject())
+        return false;
+
+    QString key;
+    while (_scanner.nextKey(key)) {
+
+        if (key == QStringLiteral("paths")) {
+
+            pathsFound = readPaths(model);
+            if (pathsFound && _pathsIndexedHandler)
+                _pathsIndexedHandler(model);
+        }
+        else if (key == QStringLiteral("definitions"))
+            definitionsFound = readDefinitions(model);
+        else
+            _scanner.skipValue();
+
+        if (_scanner.hasError())
+            break;
+    }
+
+    if (_scanner.hasError() || !pathsFound || !definitionsFound) {
+
+        model.clear();
+        return false;
+    }
+    return (model.noOfPaths() > 0 && model.noOfDefinitions() > 0);
+}
+
+bool SwaggerReader::readPaths(SwaggerModel & model) {
+
+    if (!_scanner.atObject()) {
+        _scanner.skipValue();
+        return false;
+    }
+
+    _scanner.enterObject();
+
+    QString path;
+    while (reportProgress() && _scanner.nextKey(path)) {
+
+        if (!_scanner.atObject()) {
+            _scanner.skipValue();
+            continue;
+        }
+        _scanner.enterObject();
+
+        QString method;
+        while (_scanner.nextKey(method)) {
+
+            SwaggerOperation operation;
+            if (readOperation(operation))
+                model.addOperation(path, method, operation);
+        }
+    }
+    return !_scanner.hasError();
+}
+
+bool SwaggerReader::readOperation(SwaggerOperation & operation) {
+
+    if (!_scanner.atObject()) {
+        _scanner.skipValue();
+        return false;
+    }
+
+    _scanner.enterObject();
+
+    QString summary;
+    QVector<Parameters> parameters;
+    QString inputDtoLabel;
+    QString outputDtoLabel;
+
+    QString key;
+    while (_scanner.nextKey(key)) {
+
+        if (key == QStringLiteral("summary") && _scanner.atString())
+            _scanner.readString(summary);
+        else if (key == QStringLiteral("parameters"))
+            readParameters(parameters, inputDtoLabel);
+        else if (key == QStringLiteral("responses"))
+            readResponses(outputDtoLabel);
+        else
+            _scanner.skipValue();
+    }
+
+    operation = SwaggerOperation(summary, parameters, inputDtoLabel, outputDtoLabel);
+    return !_scanner.hasError();
+}
+
+bool SwaggerReader::readParameters(QVector<Parameters> & parameters, QString & inputDtoLabel) {
+
+    if (!_scanner.atArray()) {
+        _scanner.skipValue();
+        return false;
+    }
+
+    // definition for standard POST/PUT requests: /items/schema/items/ref
+    // definition for PUT /UpdateCompany request: /item/schema/ref
+    // definition for Request type POST requests: /data/schema/ref
+    // definition for Request type PUT requests: /resultData/schema/ref
+    const static QStringList elements = { "items", "item", "data", "resultData" };
+
+    _scanner.enterArray();
+
+    while (_scanner.nextElement()) {
+
+        if (!_scanner.atObject()) {
+            _scanner.skipValue();
+            continue;
+        }
+        _scanner.enterObject();
+
+        QString name, type, format, dtoLink;
+        bool required = false;
+        bool schemaFound = false;
+
+        QString key;
+        while (_scanner.nextKey(key)) {
+
+            if (key == QStringLiteral("name") && _scanner.atString())
+                _scanner.readString(name);
+            else if (key == QStringLiteral("required") &&
+                     (_scanner.peek() == 't' || _scanner.peek() == 'f'))
+                _scanner.readBool(required);
+            else if (key == QStringLiteral("type") && _scanner.atString())
+                _scanner.readString(type);
+            else if (key == QStringLiteral("format") && _scanner.atString())
+                _scanner.readString(format);
+            else if (key == QStringLiteral("schema"))
+                schemaFound = readSchemaReference(dtoLink);
+            else
+                _scanner.skipValue();
+        }
+
+        parameters.push_back(Parameters(name, required, SwaggerModel::makeType(type, format)));
+
+        // for POST/PUT are DTOs under /parameters section
+        if (elements.contains(name, Qt::CaseInsensitive))
+            inputDtoLabel = (schemaFound) ? SwaggerModel::dtoLabelFromReference(dtoLink) : QString();
+    }
+    return !_scanner.hasError();
+}
+
+bool SwaggerReader::readResponses(QString & outputDtoLabel) {
+
+    if (!_scanner.atObject()) {
+        _scanner.skipValue();
+        return false;
+    }
+
+    // for GET are DTOs under /responses section
+    // definition for standard GET requests: /200/schema/items/ref
+    // definition for GET/{id} requests: /200/schema/ref
+    _scanner.enterObject();
+
+    QString statusCode;
+    while (_scanner.nextKey(statusCode)) {
+
+        if (statusCode != QStringLiteral("200") || !_scanner.atObject()) {
+            _scanner.skipValue();
+            continue;
+        }
+        _scanner.enterObject();
+
+        QString key;
+        while (_scanner.nextKey(key)) {
+
+            QString dtoLink;
+            if (key == QStringLiteral("schema") && readSchemaReference(dtoLink))
+                outputDtoLabel = SwaggerModel::dtoLabelFromReference(dtoLink);
+            else if (key != QStringLiteral("schema"))
+                _scanner.skipValue();
+        }
+    }
+    return !_scanner.hasError();
+}
+
+bool SwaggerReader::readSchemaReference(QString & dtoLink) {
+
+    if (!_scanner.atObject()) {
+        _scanner.skipValue();
+        return false;
+    }
+
+    _scanner.enterObject();
+
+    QString reference;
+    QString itemsReference;
+    bool itemsFound = false;
+
+    QString key;
+    while (_scanner.nextKey(key)) {
+
+        if (key == QStringLiteral("$ref") && _scanner.atString())
+            _scanner.readString(reference);
+        else if (key == QStringLiteral("items") && _scanner.atObject())
+            itemsFound = readSchemaReference(itemsReference);
+        else
+            _scanner.skipValue();
+    }
+
+    // reference of array items takes precedence
+    dtoLink = (itemsFound) ? itemsReference : reference;
+    return !_scanner.hasError();
+}
+
+bool SwaggerReader::readDefinitions(SwaggerModel & model) {
+
+    if (!_scanner.atObject()) {
+        _scanner.skipValue();
+        return false;
+    }
+
+    _scanner.enterObject();
+
+    QString dtoLabel;
+    while (reportProgress() && _scanner.nextKey(dtoLabel)) {
+
+        if (!_scanner.atObject()) {
+            _scanner.skipValue();
+            continue;
+        }
+        _scanner.enterObject();
+
+        QVector<QPair<QString, QString>> properties;
+
+        QString key;
+        while (_scanner.nextKey(key)) {
+
+            if (key == QStringLiteral("properties"))
+                readProperties(properties);
+            else
+                _scanner.skipValue();
+        }
+        model.addDefinition(dtoLabel, properties);
+    }
+    return !_scanner.hasError();
+}
+
+bool SwaggerReader::readProperties(QVector<QPair<QString, QString>> & properties) {
+
+    if (!_scanner.atObject()) {
+        _scanner.skipValue();
+        return false;
+    }
+
+    _scanner.enterObject();
+
+    QString name;
+    while (_scanner.nextKey(name)) {
+
+        QString type;
+        readType(type);
+        properties.push_back({ name, type });
+    }
+
+    // keep attributes in the same (alphabetical) order as QJsonObject::keys() used to
+    std::sort(properties.begin(), properties.end(),
+              [](const QPair<QString, QString> & lhs, const QPair<QString, QString> & rhs) -> bool
+              { return lhs.first < rhs.first; });
+
+    return !_scanner.hasError();
+}
+
+bool SwaggerReader::readType(QString & dataType) {
+
+    if (!_scanner.atObject()) {
+        _scanner.skipValue();
+        return false;
+    }
+
+    _scanner.enterObject();
+
+    QString type, format;
+
+    QString key;
+    while (_scanner.nextKey(key)) {
+
+        if (key == QStringLiteral("type") && _scanner.atString())
+            _scanner.readString(type);
+        else if (key == QStringLiteral("format") && _scanner.atString())
+            _scanner.readString(format);
+        else
+            _scanner.skipValue();
+    }
+
+    dataType = SwaggerModel::makeType(type, format);
+    return !_scanner.hasError();
+}
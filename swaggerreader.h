@@ -0,0 +1,55 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef SWAGGERREADER_H
+#define SWAGGERREADER_H
+
+#include <QByteArray>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <functional>
+#include "jsonscanner.h"
+#include "swaggermodel.h"
+
+// streaming reader of Swagger (2.0) documents: only "paths" and "definitions" are scanned,
+// everything else (info, descriptions, examples, ...) is skipped without building a DOM
+class SwaggerReader {
+
+    public:
+        // arguments: bytes read, total bytes; returns false if reading should be cancelled
+        typedef std::function<bool(const qint64, const qint64)> ProgressHandler;
+        // called once the paths section has been indexed (definitions may not be known yet)
+        typedef std::function<void(const SwaggerModel &)> PathsIndexedHandler;
+
+        explicit SwaggerReader(const QByteArray &);
+        ~SwaggerReader() {}
+
+        inline bool wasCancelled() const { return _cancelled; }
+        inline void setProgressHandler(const ProgressHandler & handler)
+            { _progressHandler = handler; return; }
+        inline void setPathsIndexedHandler(const PathsIndexedHandler & handler)
+            { _pathsIndexedHandler = handler; return; }
+
+        bool read(SwaggerModel &);
+
+    private:
+        bool reportProgress();
+        bool readPaths(SwaggerModel &);
+        bool readOperation(SwaggerOperation &);
+        bool readParameters(QVector<Parameters> &, QString &);
+        bool readResponses(QString &);
+        bool readSchemaReference(QString &);
+        bool readDefinitions(SwaggerModel &);
+        bool readProperties(QVector<QPair<QString, QString>> &);
+        bool readType(QString &);
+
+        JsonScanner _scanner;
+        bool _cancelled;
+        ProgressHandler _progressHandler;
+        PathsIndexedHandler _pathsIndexedHandler;
+};
+
+#endif // SWAGGERREADER_H
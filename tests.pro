@@ -0,0 +1,31 @@
+#-------------------------------------------------
+#
+# Unit tests (QtTest)
+# run: TAPI_tests [-o file,format]
+#
+#-------------------------------------------------
+
+QT += core testlib
+
+TARGET = TAPI_tests
+TEMPLATE = app
+
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD
+
+HEADERS += jsonquery.h \
+           jsonscanner.h \
+           uuidscanner.h \
+           tests/jsonquerytest.h \
+           tests/scalaruuidscanner.h \
+           tests/uuidscannertest.h
+
+SOURCES += jsonquery.cpp \
+           jsonscanner.cpp \
+           uuidscanner.cpp \
+           tests/jsonquerytest.cpp \
+           tests/main.cpp \
+           tests/scalaruuidscanner.cpp \
+           tests/uuidscannertest.cpp
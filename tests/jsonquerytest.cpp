@@ -0,0 +1,110 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QJsonDocument>
+#include <QtTest>
+#include "jsonquery.h"
+#include "jsonquerytest.h"
+
+void JsonQueryTest::evaluate_data() {
+
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<QString>("result");
+
+    QTest::newRow("field") << QStringLiteral("PageCount") << QStringLiteral("1");
+    QTest::newRow("leading @") << QStringLiteral("@.PageCount") << QStringLiteral("1");
+    QTest::newRow("@ with index") << QStringLiteral("@[0]") << QString();
+    QTest::newRow("index") << QStringLiteral("Data[1].Name") << QStringLiteral("b b");
+    QTest::newRow("negative index") << QStringLiteral("Data[-1].ID") << QStringLiteral("3");
+    QTest::newRow("index out of range") << QStringLiteral("Data[5].ID") << QString();
+    QTest::newRow("object") << QStringLiteral("Data[0].Address") << QStringLiteral("{\"City\":\"Praha\"}");
+    QTest::newRow("projection") << QStringLiteral("Data[*].ID") << QStringLiteral("1, 2, 3");
+    QTest::newRow("projection skips missing") << QStringLiteral("Data[*].Address.City")
+                                              << QStringLiteral("Praha, Brno");
+    QTest::newRow("object wildcard") << QStringLiteral("Data[0].Address.*") << QStringLiteral("Praha");
+    QTest::newRow("filter bool") << QStringLiteral("Data[?Deleted==false].ID") << QStringLiteral("1, 3");
+    QTest::newRow("filter existence") << QStringLiteral("Data[?Tags].ID") << QStringLiteral("2");
+    QTest::newRow("filter nested path") << QStringLiteral("Data[?Address.City=='Brno'].ID")
+                                        << QStringLiteral("3");
+    QTest::newRow("filter @") << QStringLiteral("Data[1].Tags[?@=='x']") << QStringLiteral("x");
+    QTest::newRow("filter @.") << QStringLiteral("Data[?@.ID==2].Name") << QStringLiteral("b b");
+    QTest::newRow("negative literal") << QStringLiteral("Data[?Price<-1].ID") << QStringLiteral("1");
+    QTest::newRow("negative literal after space") << QStringLiteral("Data[?Price > -2.6].ID")
+                                                  << QStringLiteral("1, 2, 3");
+    QTest::newRow("exponent") << QStringLiteral("Data[?Price>=1.5e3].ID") << QStringLiteral("2");
+    QTest::newRow("negative exponent") << QStringLiteral("Data[?Price<1E-2].ID") << QStringLiteral("1, 3");
+    QTest::newRow("negative with exponent") << QStringLiteral("Data[?Price>-2.5e0].ID")
+                                            << QStringLiteral("2, 3");
+    QTest::newRow("&&") << QStringLiteral("Data[?Deleted==false && Price>0].ID") << QStringLiteral("3");
+    QTest::newRow("&& chain") << QStringLiteral("Data[?Deleted==false&&Price>-10 && Name!='c'].ID")
+                              << QStringLiteral("1");
+    QTest::newRow("string ordering") << QStringLiteral("Data[?Name>='b'].ID") << QStringLiteral("2, 3");
+    QTest::newRow("double quoted literal") << QStringLiteral("Data[?Name==\"c\"].ID") << QStringLiteral("3");
+    QTest::newRow("number vs string") << QStringLiteral("Data[?Name>1].ID") << QString();
+    QTest::newRow("quoted key") << QStringLiteral("['key with spaces']") << QStringLiteral("7");
+    QTest::newRow("quoted key after index") << QStringLiteral("Data[2]['key with spaces']")
+                                            << QStringLiteral("k");
+    QTest::newRow("escaped quote in key") << QStringLiteral("['it\\'s']") << QStringLiteral("true");
+    QTest::newRow("spaces around") << QStringLiteral("  Data [ 0 ].ID  ") << QStringLiteral("1");
+
+    return;
+}
+
+void JsonQueryTest::evaluate() {
+
+    QFETCH(QString, expression);
+    QFETCH(QString, result);
+
+    const QJsonDocument document = QJsonDocument::fromJson(
+        "{ \"PageCount\": \"1\", \"key with spaces\": 7, \"it's\": true, \"Data\": ["
+        "  { \"ID\": 1, \"Name\": \"a\", \"Price\": -2.5, \"Deleted\": false, \"Address\": { \"City\": \"Praha\" } },"
+        "  { \"ID\": 2, \"Name\": \"b b\", \"Price\": 1500, \"Deleted\": true, \"Tags\": [\"x\"] },"
+        "  { \"ID\": 3, \"Name\": \"c\", \"Price\": 0.001, \"Deleted\": false, \"Address\": { \"City\": \"Brno\" },"
+        "    \"key with spaces\": \"k\" } ] }");
+    QVERIFY(document.isObject());
+
+    const JsonQuery query(expression);
+    QVERIFY2(query.isValid(), qPrintable(query.error()));
+    QCOMPARE(JsonQuery::toText(query.evaluate(document.object()), true), result);
+
+    return;
+}
+
+void JsonQueryTest::compileError_data() {
+
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<QString>("error");
+
+    QTest::newRow("empty") << QStringLiteral("  ") << QStringLiteral("prázdný dotaz (pozice 1)");
+    QTest::newRow("trailing dot") << QStringLiteral("Data.") << QStringLiteral("očekáván název atributu (pozice 6)");
+    QTest::newRow("double dot") << QStringLiteral("Data..ID") << QStringLiteral("očekáván název atributu (pozice 6)");
+    QTest::newRow("missing dot") << QStringLiteral("Data ID") << QStringLiteral("očekávána tečka nebo [ (pozice 6)");
+    QTest::newRow("empty filter") << QStringLiteral("[?]") << QStringLiteral("očekávána podmínka (pozice 3)");
+    QTest::newRow("filter without path") << QStringLiteral("Data[?@]") << QStringLiteral("očekávána podmínka (pozice 8)");
+    QTest::newRow("dangling &&") << QStringLiteral("Data[?A==1 &&]") << QStringLiteral("očekávána podmínka (pozice 14)");
+    QTest::newRow("single =") << QStringLiteral("Data[?A=1]") << QStringLiteral("očekávána ] (pozice 8)");
+    QTest::newRow("missing literal") << QStringLiteral("Data[?Price>]") << QStringLiteral("neplatná hodnota (pozice 13)");
+    QTest::newRow("invalid literal") << QStringLiteral("Data[?Price>1x]") << QStringLiteral("neplatná hodnota (pozice 15)");
+    QTest::newRow("unterminated string") << QStringLiteral("Data[?Name=='x]")
+                                         << QStringLiteral("neukončený řetězec (pozice 16)");
+    QTest::newRow("unclosed bracket") << QStringLiteral("Data[") << QStringLiteral("očekáván index, * nebo ?podmínka (pozice 6)");
+    QTest::newRow("missing ]") << QStringLiteral("Data[0") << QStringLiteral("očekávána ] (pozice 7)");
+    QTest::newRow("minus only") << QStringLiteral("Data[-]") << QStringLiteral("očekáván index, * nebo ?podmínka (pozice 7)");
+
+    return;
+}
+
+void JsonQueryTest::compileError() {
+
+    QFETCH(QString, expression);
+    QFETCH(QString, error);
+
+    const JsonQuery query(expression);
+    QVERIFY(!query.isValid());
+    QCOMPARE(query.error(), error);
+    QVERIFY(query.evaluate(QJsonValue(QJsonValue::Null)).isEmpty());
+
+    return;
+}
@@ -0,0 +1,23 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef JSONQUERYTEST_H
+#define JSONQUERYTEST_H
+
+#include <QObject>
+
+// JsonQuery: expression => values (single line text) or compile error
+class JsonQueryTest: public QObject {
+
+    Q_OBJECT
+
+    private slots:
+        void evaluate_data();
+        void evaluate();
+        void compileError_data();
+        void compileError();
+};
+
+#endif // JSONQUERYTEST_H
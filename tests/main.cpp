@@ -0,0 +1,24 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QCoreApplication>
+#include <QtTest>
+#include "jsonquerytest.h"
+#include "uuidscannertest.h"
+
+// every test class is run (exit code = number of failed tests)
+int main(int argc, char * argv[]) {
+
+    QCoreApplication application(argc, argv);
+    int failed = 0;
+
+    JsonQueryTest jsonQueryTest;
+    failed += QTest::qExec(&jsonQueryTest, argc, argv);
+
+    UuidScannerTest uuidScannerTest;
+    failed += QTest::qExec(&uuidScannerTest, argc, argv);
+
+    return failed;
+}
@@ -0,0 +1,9 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+// declaration comes from uuidscanner.h included by uuidscanner.cpp (see scalaruuidscanner.h)
+#undef __SSE2__
+#define UuidScanner ScalarUuidScanner
+#include "uuidscanner.cpp"
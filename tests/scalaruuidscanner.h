@@ -0,0 +1,18 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef SCALARUUIDSCANNER_H
+#define SCALARUUIDSCANNER_H
+
+// UuidScanner built from the same source without SSE2 (see scalaruuidscanner.cpp)
+// => scalar implementation is tested on x86-64 as well
+#pragma push_macro("UUIDSCANNER_H")
+#undef UUIDSCANNER_H
+#define UuidScanner ScalarUuidScanner
+#include "uuidscanner.h"
+#undef UuidScanner
+#pragma pop_macro("UUIDSCANNER_H")
+
+#endif // SCALARUUIDSCANNER_H
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QtTest>
+#include <QUuid>
+#include "scalaruuidscanner.h"
+#include "uuidscanner.h"
+#include "uuidscannertest.h"
+
+void UuidScannerTest::read_data() {
+
+    QTest::addColumn<QByteArray>("text");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("lower case") << QByteArray("6f9619ff-8b86-d011-b42d-00cf4fc964ff") << true;
+    QTest::newRow("upper case") << QByteArray("6F9619FF-8B86-D011-B42D-00CF4FC964FF") << true;
+    QTest::newRow("mixed case") << QByteArray("6f9619FF-8b86-D011-b42D-00cF4fC964Ff") << true;
+    QTest::newRow("digits only") << QByteArray("12345678-9012-3456-7890-123456789012") << true;
+    QTest::newRow("letter bounds") << QByteArray("abcdefAB-CDEF-0a9f-A0F9-fedcbaFEDCBA") << true;
+    QTest::newRow("braces") << QByteArray("{6F9619FF-8b86-d011-b42d-00cf4fc964ff}") << true;
+    QTest::newRow("g") << QByteArray("6f9619fg-8b86-d011-b42d-00cf4fc964ff") << false;
+    QTest::newRow("G in second half") << QByteArray("6f9619ff-8b86-d011-b42d-00cf4fc964fG") << false;
+    QTest::newRow("colon") << QByteArray("6f9619ff-8b86-d011-b42d-00cf4fc96:ff") << false;
+    QTest::newRow("slash") << QByteArray("6f9619ff-8b86-d011-b42d-/0cf4fc964ff") << false;
+    QTest::newRow("at sign") << QByteArray("@f9619ff-8b86-d011-b42d-00cf4fc964ff") << false;
+    QTest::newRow("backtick") << QByteArray("6f9619ff-8b86-d0`1-b42d-00cf4fc964ff") << false;
+    QTest::newRow("byte 0x80") << QByteArray("6f9619ff-8b86-d011-b42d-00cf4fc964f\x80") << false;
+    QTest::newRow("byte 0xC3") << QByteArray("6f96\xC3" "9ff-8b86-d011-b42d-00cf4fc964ff") << false;
+    QTest::newRow("space") << QByteArray("6f9619ff-8b86-d011-b42d-00cf4fc9 4ff") << false;
+    QTest::newRow("misplaced dash") << QByteArray("6f9619f-f8b86-d011-b42d-00cf4fc964ff") << false;
+    QTest::newRow("dash replaced") << QByteArray("6f9619ff08b86-d011-b42d-00cf4fc964ff") << false;
+    QTest::newRow("null uuid") << QByteArray("00000000-0000-0000-0000-000000000000") << false;
+    QTest::newRow("too short") << QByteArray("6f9619ff-8b86-d011-b42d-00cf4fc964f") << false;
+
+    return;
+}
+
+// both implementations give the same result as QUuid (null uuid is not valid record ID)
+void UuidScannerTest::read() {
+
+    QFETCH(QByteArray, text);
+    QFETCH(bool, valid);
+
+    const QUuid expected(QString::fromLatin1(text));
+    QCOMPARE(!(expected.isNull()), valid);
+
+    QUuid uuid;
+    QCOMPARE(UuidScanner::read(text.constData(), text.size(), uuid), valid);
+    if (valid)
+        QCOMPARE(uuid, expected);
+
+    QUuid scalarUuid;
+    QCOMPARE(ScalarUuidScanner::read(text.constData(), text.size(), scalarUuid), valid);
+    if (valid)
+        QCOMPARE(scalarUuid, expected);
+
+    return;
+}
+
+void UuidScannerTest::readArray() {
+
+    const QByteArray array("[\"6F9619FF-8B86-D011-B42D-00CF4FC964FF\", \"{6f9619ff-8b86-d011-b42d-00cf4fc964fe}\","
+                           " 1, \"6f9619fg-8b86-d011-b42d-00cf4fc964ff\", null] ");
+    const QVector<QUuid> expected =
+        { QUuid(QStringLiteral("6f9619ff-8b86-d011-b42d-00cf4fc964ff")),
+          QUuid(QStringLiteral("6f9619ff-8b86-d011-b42d-00cf4fc964fe")) };
+
+    QVector<QUuid> uuids;
+    qint64 end = 0;
+    QCOMPARE(UuidScanner::readArray(array.constData(), array.size(), uuids, &end), 3);
+    QCOMPARE(uuids, expected);
+    QCOMPARE(end, static_cast<qint64>(array.size() - 1));
+
+    QVector<QUuid> scalarUuids;
+    QCOMPARE(ScalarUuidScanner::readArray(array.constData(), array.size(), scalarUuids), 3);
+    QCOMPARE(scalarUuids, expected);
+
+    // unterminated array
+    const QByteArray truncated = array.left(40);
+    QVector<QUuid> ignored;
+    QCOMPARE(UuidScanner::readArray(truncated.constData(), truncated.size(), ignored), -1);
+    QCOMPARE(ScalarUuidScanner::readArray(truncated.constData(), truncated.size(), ignored), -1);
+
+    return;
+}
@@ -0,0 +1,22 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef UUIDSCANNERTEST_H
+#define UUIDSCANNERTEST_H
+
+#include <QObject>
+
+// UuidScanner (SSE2 and scalar implementation) checked against QUuid
+class UuidScannerTest: public QObject {
+
+    Q_OBJECT
+
+    private slots:
+        void read_data();
+        void read();
+        void readArray();
+};
+
+#endif // UUIDSCANNERTEST_H
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <QFile>
+#include <QTextStream>
+#include "timingstatistics.h"
+
+const QVector<int> TimingStatistics::percentiles = { 50, 90, 95, 99 };
+const QRegularExpression TimingStatistics::idSegmentRegex = QRegularExpression(
+    QStringLiteral("^(\\d+|\\{?[0-9A-Fa-f]{8}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{12}\\}?)$"));
+
+QString TimingStatistics::endpoint(const http::httpMethodType httpMethod, const QUrl & url) {
+
+    QStringList segments = url.path().split(QLatin1Char('/'));
+    for (auto & it: segments)
+        if (idSegmentRegex.match(it).hasMatch())
+            it = QStringLiteral("{id}");
+
+    return http::convertEnumValueToText(httpMethod) + QLatin1Char(' ') + segments.join(QLatin1Char('/'));
+}
+
+// nearest-rank percentile of sorted durations
+qint64 TimingStatistics::percentile(const QVector<qint64> & sorted, const int percent) {
+
+    if (sorted.isEmpty())
+        return -1;
+
+    const int rank = (percent * sorted.size() + 99) / 100;
+    return sorted.at(qBound(0, rank - 1, sorted.size() - 1));
+}
+
+void TimingStatistics::add(const http::httpMethodType httpMethod, const QUrl & url,
+                           const RequestTiming & timing) {
+
+    // messages without reply (test mode, journal entries written before timing was recorded)
+    if (!timing.isValid())
+        return;
+
+    QVector<QVector<qint64>> & samples = _samples[endpoint(httpMethod, url)];
+    if (samples.isEmpty())
+        samples.resize(PROCESSING + 1);
+
+    // unknown phase (e.g. sending of plain GET) is left out
+    const qint64 durations[] = { timing.total(), timing.sending(), timing.waiting(),
+                                 timing.receiving(), timing.processing() };
+    for (int i = TOTAL; i <= PROCESSING; ++i)
+        if (durations[i] >= 0)
+            samples[i].push_back(durations[i]);
+
+    return;
+}
+
+// one row per endpoint: count, then percentiles and maximum (ms) of every phase
+bool TimingStatistics::exportToCsv(const QString & fileName) const {
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    stream.setGenerateByteOrderMark(true);
+
+    const QStringList phases = { QStringLiteral("celkem"), QStringLiteral("odeslání"), QStringLiteral("server"),
+                                 QStringLiteral("příjem"), QStringLiteral("zpracování") };
+
+    stream << QStringLiteral("Endpoint;Počet");
+    for (const auto & phase: phases) {
+
+        for (const auto it: percentiles)
+            stream << ';' << phase << QStringLiteral(" p") << it;
+        stream << ';' << phase << QStringLiteral(" max");
+    }
+    stream << '\n';
+
+    for (auto it = _samples.constBegin(); it != _samples.constEnd(); ++it) {
+
+        QString name = it.key();
+        stream << '"' << name.replace(QLatin1Char('"'), QStringLiteral("\"\"")) << '"' << ';'
+               << it.value().at(TOTAL).size();
+
+        for (QVector<qint64> durations: it.value()) {
+
+            std::sort(durations.begin(), durations.end());
+            for (const auto percent: percentiles)
+                stream << ';' << ((durations.isEmpty()) ? QString() : QString::number(percentile(durations, percent)));
+            stream << ';' << ((durations.isEmpty()) ? QString() : QString::number(durations.last()));
+        }
+        stream << '\n';
+    }
+
+    stream.flush();
+    return (stream.status() == QTextStream::Ok && file.error() == QFileDevice::NoError);
+}
@@ -0,0 +1,41 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef TIMINGSTATISTICS_H
+#define TIMINGSTATISTICS_H
+
+#include <QMap>
+#include <QRegularExpression>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+#include "methods.h"
+#include "request.h"
+
+// percentiles of message's phases (see RequestTiming) per endpoint; endpoint is http method
+// and path whose record IDs and numbers are replaced by {id} (query is left out)
+class TimingStatistics {
+
+    public:
+        enum Phase { TOTAL = 0, SENDING = 1, WAITING = 2, RECEIVING = 3, PROCESSING = 4 };
+        const static QVector<int> percentiles;
+        const static QRegularExpression idSegmentRegex;
+
+        TimingStatistics() {}
+        ~TimingStatistics() {}
+
+        inline int endpointCount() const { return _samples.size(); }
+
+        static QString endpoint(const http::httpMethodType, const QUrl &);
+        static qint64 percentile(const QVector<qint64> &, const int);
+
+        void add(const http::httpMethodType, const QUrl &, const RequestTiming &);
+        bool exportToCsv(const QString &) const;
+
+    private:
+        QMap<QString, QVector<QVector<qint64>>> _samples; // endpoint => durations of every phase
+};
+
+#endif // TIMINGSTATISTICS_H
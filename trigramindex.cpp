@@ -0,0 +1,502 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <iterator>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include "trigramindex.h"
+
+TrigramIndex::TrigramIndex(const QString & filePath):
+    _file(filePath), _loaded(false), _entryCount(0), _pendingFirst(0), _pendingPostings(0) {
+
+    _file.open(QIODevice::ReadWrite);
+}
+
+TrigramIndex::~TrigramIndex() {
+
+    for (auto & it: _segments)
+        this->closeSegment(it);
+}
+
+QByteArray TrigramIndex::normalized(const QByteArray & text) {
+
+    QByteArray lowerCase = text;
+    for (char & it: lowerCase)
+        if (it >= 'A' && it <= 'Z')
+            it = static_cast<char>(it + ('a' - 'A'));
+
+    return lowerCase;
+}
+
+void TrigramIndex::collect(const QByteArray & text) {
+
+    if (_seen.isEmpty())
+        _seen.fill(0, (1 << 24) / 64);
+
+    const QByteArray lowerCase = normalized(text);
+    const uchar * const data = reinterpret_cast<const uchar *>(lowerCase.constData());
+
+    for (int i = 2; i < lowerCase.size(); ++i) {
+
+        const quint32 key = trigram(data[i - 2], data[i - 1], data[i]);
+        quint64 & word = _seen[static_cast<int>(key >> 6)];
+        if (word == 0)
+            _touchedWords.push_back(static_cast<int>(key >> 6));
+        word |= (Q_UINT64_C(1) << (key & 63));
+    }
+    return;
+}
+
+// collected trigrams in ascending order (bitmap is cleared); only touched words are visited
+// => cost depends on entry's size, not on size of bitmap
+QVector<quint32> TrigramIndex::takeCollected() {
+
+    QVector<quint32> trigrams;
+    std::sort(_touchedWords.begin(), _touchedWords.end());
+
+    for (const auto word: qAsConst(_touchedWords)) {
+
+        quint64 bits = _seen.at(word);
+        for (quint32 bit = 0; bits != 0; ++bit, bits >>= 1)
+            if (bits & 1)
+                trigrams.push_back((static_cast<quint32>(word) << 6) | bit);
+
+        _seen[word] = 0;
+    }
+    _touchedWords.clear();
+
+    return trigrams;
+}
+
+void TrigramIndex::insert(const quint32 entry, const QVector<quint32> & trigrams) {
+
+    for (const auto it: trigrams)
+        _pending[it].push_back(entry);
+
+    _pendingPostings += trigrams.size();
+    _entryCount = entry + 1;
+    return;
+}
+
+QString TrigramIndex::segmentPath(const quint32 first, const quint32 end) const {
+
+    return _file.fileName() + QLatin1Char('.') + QString::number(first) + QLatin1Char('-') +
+           QString::number(end);
+}
+
+bool TrigramIndex::openSegment(const QString & path, Segment & segment) const {
+
+    QFile * const file = new QFile(path);
+    const qint64 size = file->size();
+    const qint64 words = size / static_cast<qint64>(sizeof(quint32));
+    uchar * const mapped = (file->open(QIODevice::ReadOnly) && size % sizeof(quint32) == 0 &&
+                            words >= trailerSize) ? file->map(0, size) : nullptr;
+    if (mapped == nullptr) {
+
+        delete file;
+        return false;
+    }
+
+    const quint32 * const data = reinterpret_cast<const quint32 *>(mapped);
+    const quint32 * const trailer = data + words - trailerSize;
+    if (trailer[0] != segmentMagic || trailer[2] > trailer[3] ||
+        3 * static_cast<qint64>(trailer[4]) > words - trailerSize) {
+
+        file->unmap(mapped);
+        delete file;
+        return false;
+    }
+
+    segment.file = file;
+    segment.data = data;
+    segment.directory = trailer - 3 * static_cast<qint64>(trailer[4]);
+    segment.level = trailer[1];
+    segment.first = trailer[2];
+    segment.end = trailer[3];
+    segment.trigramCount = trailer[4];
+    return true;
+}
+
+void TrigramIndex::closeSegment(Segment & segment, const bool remove) const {
+
+    segment.file->unmap(const_cast<uchar *>(reinterpret_cast<const uchar *>(segment.data)));
+    segment.file->close();
+    if (remove)
+        segment.file->remove();
+    delete segment.file;
+    segment.file = nullptr;
+    return;
+}
+
+// postings are already written; directory and trailer complete the segment
+bool TrigramIndex::finishSegment(QFile & file, const QVector<quint32> & directory, const quint32 level,
+                                 const quint32 first, const quint32 end) {
+
+    const quint32 trailer[trailerSize] =
+        { segmentMagic, level, first, end, static_cast<quint32>(directory.size() / 3) };
+    const qint64 directorySize = directory.size() * static_cast<qint64>(sizeof(quint32));
+
+    return (file.write(reinterpret_cast<const char *>(directory.constData()), directorySize) == directorySize &&
+            file.write(reinterpret_cast<const char *>(trailer), sizeof(trailer)) == sizeof(trailer) &&
+            file.flush());
+}
+
+// segment written to temporary file replaces any previous one of the same range
+bool TrigramIndex::installSegment(QFile & file, const quint32 level, const quint32 first, const quint32 end) {
+
+    file.close();
+    const QString path = this->segmentPath(first, end);
+    QFile::remove(path);
+
+    Segment segment;
+    if (!file.rename(path) || !this->openSegment(path, segment) || segment.level != level) {
+
+        file.remove();
+        return false;
+    }
+
+    _segments.push_back(segment);
+    return true;
+}
+
+// entries kept in memory are moved to new segment (log is cleared by caller)
+bool TrigramIndex::flushPending() {
+
+    QVector<quint32> trigrams = _pending.keys().toVector();
+    std::sort(trigrams.begin(), trigrams.end());
+
+    QFile file(this->segmentPath(_pendingFirst, _entryCount) + QStringLiteral(".tmp"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QVector<quint32> directory;
+    directory.reserve(3 * trigrams.size());
+    quint32 offset = 0;
+    bool written = true;
+
+    for (int i = 0; i < trigrams.size() && written; ++i) {
+
+        const QVector<quint32> & postings = _pending[trigrams.at(i)];
+        const qint64 size = postings.size() * static_cast<qint64>(sizeof(quint32));
+        written = (file.write(reinterpret_cast<const char *>(postings.constData()), size) == size);
+
+        directory << trigrams.at(i) << offset << static_cast<quint32>(postings.size());
+        offset += static_cast<quint32>(postings.size());
+    }
+
+    if (!written || !finishSegment(file, directory, 0, _pendingFirst, _entryCount) ||
+        !this->installSegment(file, 0, _pendingFirst, _entryCount)) {
+
+        file.remove();
+        return false;
+    }
+
+    _pending.clear();
+    _pendingPostings = 0;
+    _pendingFirst = _entryCount;
+
+    while (this->mergeSegments()) {}
+    return true;
+}
+
+// last mergeFactor segments of the same level are merged into one of the next level; postings
+// of every trigram are copied from mapped segments in order of their ranges => they stay sorted
+bool TrigramIndex::mergeSegments() {
+
+    const int from = _segments.size() - mergeFactor;
+    if (from < 0)
+        return false;
+
+    const quint32 level = _segments.last().level;
+    for (int i = from; i < _segments.size(); ++i)
+        if (_segments.at(i).level != level)
+            return false;
+
+    const quint32 first = _segments.at(from).first;
+    const quint32 end = _segments.last().end;
+    QFile file(this->segmentPath(first, end) + QStringLiteral(".tmp"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QVector<quint32> cursors(mergeFactor, 0);
+    QVector<quint32> directory;
+    quint32 offset = 0;
+    bool written = true;
+
+    while (written) {
+
+        // the smallest trigram which has not been copied yet
+        quint32 key = 0xFFFFFFFF;
+        for (int i = 0; i < mergeFactor; ++i) {
+
+            const Segment & segment = _segments.at(from + i);
+            if (cursors.at(i) < segment.trigramCount)
+                key = qMin(key, segment.directory[3 * cursors.at(i)]);
+        }
+        if (key == 0xFFFFFFFF)
+            break;
+
+        quint32 count = 0;
+        for (int i = 0; i < mergeFactor && written; ++i) {
+
+            const Segment & segment = _segments.at(from + i);
+            if (cursors.at(i) >= segment.trigramCount || segment.directory[3 * cursors.at(i)] != key)
+                continue;
+
+            const Postings postings = find(segment, key);
+            const qint64 size = (postings.end - postings.begin) * static_cast<qint64>(sizeof(quint32));
+            written = (file.write(reinterpret_cast<const char *>(postings.begin), size) == size);
+            count += static_cast<quint32>(postings.end - postings.begin);
+            ++cursors[i];
+        }
+
+        directory << key << offset << count;
+        offset += count;
+    }
+
+    if (!written || !finishSegment(file, directory, level + 1, first, end)) {
+
+        file.remove();
+        return false;
+    }
+
+    // merged segments are removed only when new one is in place
+    QVector<Segment> merged = _segments.mid(from);
+    _segments.resize(from);
+    if (!this->installSegment(file, level + 1, first, end)) {
+
+        _segments += merged;
+        return false;
+    }
+
+    for (auto & it: merged)
+        this->closeSegment(it, true);
+    return true;
+}
+
+// texts of one entry (e.g. url and headers, request body, response body)
+bool TrigramIndex::add(const quint32 entry, const QVector<QByteArray> & texts) {
+
+    if (!this->load() || entry != _entryCount)
+        return false;
+
+    for (const auto & it: texts)
+        this->collect(it);
+    const QVector<quint32> trigrams = this->takeCollected();
+
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << entry << static_cast<quint32>(trigrams.size());
+    for (const auto it: trigrams)
+        stream << it;
+
+    const qint64 offset = _file.size();
+    if (!_file.seek(offset) || _file.write(record) != record.size()) {
+
+        _file.resize(offset);
+        return false;
+    }
+    _file.flush();
+
+    this->insert(entry, trigrams);
+
+    // log is cleared once its entries are in segment (flush is retried by next entry otherwise)
+    if (_pendingPostings >= maxPendingPostings && this->flushPending())
+        _file.resize(0);
+
+    return true;
+}
+
+// segments are mapped (nothing is read until search) and entries of log are kept in memory
+bool TrigramIndex::load() {
+
+    if (_loaded)
+        return true;
+    if (!_file.isOpen())
+        return false;
+
+    // segments must cover consecutive ranges from entry 0; larger segment wins (interrupted merge)
+    // and segments which do not fit are removed (their entries are indexed again, see Journal)
+    const QFileInfo fileInfo(_file.fileName());
+    const QDir directory = fileInfo.dir();
+    QVector<Segment> found;
+
+    for (const auto & it: directory.entryList({ fileInfo.fileName() + QStringLiteral(".*") }, QDir::Files)) {
+
+        const QString path = directory.filePath(it);
+        Segment segment;
+        const bool opened = (!it.endsWith(QStringLiteral(".tmp")) && this->openSegment(path, segment));
+
+        if (opened && path == this->segmentPath(segment.first, segment.end)) {
+
+            found.push_back(segment);
+            continue;
+        }
+        if (opened)
+            this->closeSegment(segment);
+        QFile::remove(path);
+    }
+
+    std::sort(found.begin(), found.end(), [](const Segment & a, const Segment & b)
+        { return (a.first < b.first || (a.first == b.first && a.end > b.end)); });
+
+    _entryCount = 0;
+    for (auto & it: found) {
+
+        if (it.first == _entryCount && it.end > it.first) {
+
+            _segments.push_back(it);
+            _entryCount = it.end;
+        }
+        else
+            this->closeSegment(it, true);
+    }
+    _pendingFirst = _entryCount;
+
+    if (!_file.seek(0))
+        return false;
+
+    QDataStream stream(&_file);
+    qint64 pendingOffset = 0; // records before are in segments
+    qint64 validSize = 0;
+
+    while (!stream.atEnd()) {
+
+        quint32 entry = 0;
+        quint32 count = 0;
+        stream >> entry >> count;
+        if (stream.status() != QDataStream::Ok || count > (1u << 24))
+            break;
+
+        QVector<quint32> trigrams(static_cast<int>(count));
+        for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+            stream >> trigrams[static_cast<int>(i)];
+
+        // incomplete record (interrupted write) and records after missing entry are dropped
+        if (stream.status() != QDataStream::Ok || entry > _entryCount)
+            break;
+
+        validSize = _file.pos();
+
+        // record written before its segment was completed
+        if (entry < _entryCount) {
+
+            if (_pendingFirst == _entryCount)
+                pendingOffset = validSize;
+            continue;
+        }
+
+        this->insert(entry, trigrams);
+        if (_pendingPostings >= maxPendingPostings && this->flushPending())
+            pendingOffset = validSize;
+    }
+
+    // only records of entries kept in memory stay in log
+    if (pendingOffset > 0 || validSize != _file.size()) {
+
+        QByteArray records;
+        if (_file.seek(pendingOffset))
+            records = _file.read(validSize - pendingOffset);
+        _file.resize(0);
+        _file.seek(0);
+        _file.write(records);
+        _file.flush();
+    }
+
+    _loaded = true;
+    return true;
+}
+
+TrigramIndex::Postings TrigramIndex::find(const Segment & segment, const quint32 key) {
+
+    const Postings none = { nullptr, nullptr };
+    quint32 low = 0;
+    quint32 high = segment.trigramCount;
+
+    while (low < high) {
+
+        const quint32 middle = low + (high - low) / 2;
+        if (segment.directory[3 * middle] < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == segment.trigramCount || segment.directory[3 * low] != key)
+        return none;
+
+    // damaged segment is never read beyond its postings
+    const quint32 offset = segment.directory[3 * low + 1];
+    const quint32 count = segment.directory[3 * low + 2];
+    if (static_cast<qint64>(offset) + count > segment.directory - segment.data)
+        return none;
+
+    return { segment.data + offset, segment.data + offset + count };
+}
+
+// intersection (starting with the shortest list) is appended to result
+void TrigramIndex::intersect(QVector<Postings> & postings, QVector<quint32> & result) {
+
+    std::sort(postings.begin(), postings.end(),
+              [](const Postings & a, const Postings & b) { return (a.end - a.begin) < (b.end - b.begin); });
+
+    QVector<quint32> current;
+    std::copy(postings.first().begin, postings.first().end, std::back_inserter(current));
+
+    for (int i = 1; i < postings.size() && !current.isEmpty(); ++i) {
+
+        QVector<quint32> intersection;
+        std::set_intersection(current.constBegin(), current.constEnd(), postings.at(i).begin,
+                              postings.at(i).end, std::back_inserter(intersection));
+        current.swap(intersection);
+    }
+
+    result += current;
+    return;
+}
+
+// entries which contain all trigrams of text (text itself must be verified by caller);
+// segments cover consecutive ranges => result is in ascending order
+QVector<quint32> TrigramIndex::candidates(const QString & text) {
+
+    QVector<quint32> result;
+    const QByteArray query = normalized(text.toUtf8());
+    if (query.size() < minQueryLength || !this->load())
+        return result;
+
+    QVector<quint32> trigrams;
+    const uchar * const data = reinterpret_cast<const uchar *>(query.constData());
+    for (int i = 2; i < query.size(); ++i)
+        trigrams.push_back(trigram(data[i - 2], data[i - 1], data[i]));
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+    QVector<Postings> postings;
+    for (const auto & segment: qAsConst(_segments)) {
+
+        postings.clear();
+        for (int i = 0; i < trigrams.size() && postings.size() == i; ++i) {
+
+            const Postings found = find(segment, trigrams.at(i));
+            if (found.begin != found.end)
+                postings.push_back(found);
+        }
+        if (postings.size() == trigrams.size())
+            intersect(postings, result);
+    }
+
+    postings.clear();
+    for (int i = 0; i < trigrams.size() && postings.size() == i; ++i) {
+
+        const auto it = _pending.constFind(trigrams.at(i));
+        if (it != _pending.constEnd())
+            postings.push_back({ it.value().constData(), it.value().constData() + it.value().size() });
+    }
+    if (postings.size() == trigrams.size())
+        intersect(postings, result);
+
+    return result;
+}
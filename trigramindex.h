@@ -0,0 +1,93 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+// inverted index: trigram (3 consecutive bytes, ascii letters in lower case) => entries containing it;
+// postings are kept in immutable segment files (<file>.<first entry>-<end entry>) which are
+// memory-mapped and searched one by one => nothing is rebuilt when index is opened;
+// entries added since the last segment was written are kept in memory and in log file
+// (entry, count, trigrams) until they have maxPendingPostings postings; mergeFactor segments
+// of the same level are merged into one => number of segments grows with logarithm of entries
+class TrigramIndex {
+
+    public:
+        const static int minQueryLength = 3;
+        const static int maxPendingPostings = 1 << 20;
+        const static int mergeFactor = 8;
+
+        explicit TrigramIndex(const QString &);
+        ~TrigramIndex();
+
+        inline bool isOpen() const { return _file.isOpen(); }
+        inline bool isLoaded() const { return _loaded; }
+        // entries are added in order => entries 0 .. entryCount() - 1 are indexed
+        inline quint32 entryCount() const { return _entryCount; }
+
+        bool load();
+        bool add(const quint32, const QVector<QByteArray> &);
+        QVector<quint32> candidates(const QString &);
+
+        static QByteArray normalized(const QByteArray &);
+
+    private:
+        const static quint32 segmentMagic = 0x54475331; // "TGS1"
+        const static int trailerSize = 5; // magic, level, first entry, end entry, number of trigrams
+
+        // segment: postings of all trigrams, directory { trigram, offset, count } sorted by trigram
+        // and trailer; file is mapped at page boundary => values are read in place
+        struct Segment {
+
+            QFile * file;
+            const quint32 * data;
+            const quint32 * directory;
+            quint32 level;
+            quint32 first;
+            quint32 end; // entry after the last one
+            quint32 trigramCount;
+        };
+
+        struct Postings {
+
+            const quint32 * begin;
+            const quint32 * end;
+        };
+
+        static inline quint32 trigram(const uchar a, const uchar b, const uchar c)
+            { return (static_cast<quint32>(a) << 16) | (static_cast<quint32>(b) << 8) | c; }
+        static Postings find(const Segment &, const quint32);
+        static void intersect(QVector<Postings> &, QVector<quint32> &);
+        static bool finishSegment(QFile &, const QVector<quint32> &, const quint32, const quint32,
+                                  const quint32);
+
+        void collect(const QByteArray &);
+        QVector<quint32> takeCollected();
+        void insert(const quint32, const QVector<quint32> &);
+        QString segmentPath(const quint32, const quint32) const;
+        bool openSegment(const QString &, Segment &) const;
+        void closeSegment(Segment &, const bool = false) const;
+        bool installSegment(QFile &, const quint32, const quint32, const quint32);
+        bool flushPending();
+        bool mergeSegments();
+
+        QFile _file; // log of entries which are not in segments yet
+        bool _loaded;
+        quint32 _entryCount;
+        QVector<Segment> _segments; // consecutive ranges of entries (from entry 0)
+        QHash<quint32, QVector<quint32>> _pending; // postings of entries in log (sorted entries)
+        quint32 _pendingFirst;
+        int _pendingPostings;
+        QVector<quint64> _seen; // bitmap of all 2^24 trigrams (reused for every entry)
+        QVector<int> _touchedWords; // words of bitmap which are not zero
+};
+
+#endif // TRIGRAMINDEX_H
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef UI_DATATABLEWINDOW_H
+#define UI_DATATABLEWINDOW_H
+
+// user interface for DataTableWindow class
+
+#include <QAction>
+#include <QComboBox>
+#include <QDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QIcon>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMenu>
+#include <QPushButton>
+#include <QTableView>
+#include <QVBoxLayout>
+#include "datatablemodel.h"
+
+class Ui_DataTableWindow {
+
+    public:
+        QIcon * dataTableWindowIcon;
+
+        QHBoxLayout * filterLayout;
+        QLabel * filterLabel;
+        QComboBox * filterColumnComboBox;
+        QLineEdit * filterLineEdit;
+        QLabel * rowCountLabel;
+
+        QTableView * dataTableView;
+
+        QHBoxLayout * buttonsLayout;
+        QPushButton * columnsButton;
+        QMenu * columnsMenu;
+        QPushButton * closeButton;
+
+        QVBoxLayout * windowLayout;
+
+        void setupUi(QDialog * DataTableWindow, DataTableModel * const model, const QString & url) {
+
+            // properties of main window
+            dataTableWindowIcon = new QIcon(QStringLiteral(":/icons/icons/document-preview.png"));
+            DataTableWindow->setWindowIcon(*dataTableWindowIcon);
+            DataTableWindow->resize(900,600);
+            DataTableWindow->setWindowTitle(QStringLiteral("Data (") + url + QStringLiteral(")"));
+
+            // filter
+            filterLayout = new QHBoxLayout;
+            filterLabel = new QLabel(QStringLiteral("Filtr"));
+            filterColumnComboBox = new QComboBox;
+            filterColumnComboBox->addItem(QStringLiteral("všechny sloupce"));
+            for (int i = 0; i < model->columnCount(); ++i)
+                filterColumnComboBox->addItem(model->table().column(i).name());
+            filterLineEdit = new QLineEdit;
+            filterLineEdit->setClearButtonEnabled(true);
+            rowCountLabel = new QLabel;
+            filterLayout->addWidget(filterLabel);
+            filterLayout->addWidget(filterColumnComboBox);
+            filterLayout->addWidget(filterLineEdit);
+            filterLayout->addWidget(rowCountLabel);
+
+            // table (only visible rows are requested from model)
+            dataTableView = new QTableView;
+            dataTableView->setModel(model);
+            dataTableView->setSortingEnabled(true);
+            dataTableView->sortByColumn(-1, Qt::AscendingOrder);
+            dataTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+            dataTableView->setWordWrap(false);
+            dataTableView->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft);
+            dataTableView->horizontalHeader()->setSectionsMovable(true);
+            dataTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+            dataTableView->verticalHeader()->setDefaultSectionSize(dataTableView->fontMetrics().height() + 4);
+
+            // buttons
+            buttonsLayout = new QHBoxLayout;
+            columnsButton = new QPushButton(QStringLiteral("Sloupce"));
+            columnsMenu = new QMenu(columnsButton);
+            for (int i = 0; i < model->columnCount(); ++i) {
+
+                QAction * column = columnsMenu->addAction(model->table().column(i).name());
+                column->setCheckable(true);
+                column->setChecked(true);
+                column->setData(i);
+            }
+            columnsButton->setMenu(columnsMenu);
+            closeButton = new QPushButton(QIcon(QStringLiteral(":/icons/icons/edit-delete.png")),
+                                          QStringLiteral("Zavřít"));
+            buttonsLayout->addWidget(columnsButton);
+            buttonsLayout->addStretch();
+            buttonsLayout->addWidget(closeButton);
+
+            windowLayout = new QVBoxLayout(DataTableWindow);
+            windowLayout->addLayout(filterLayout);
+            windowLayout->addWidget(dataTableView);
+            windowLayout->addLayout(buttonsLayout);
+
+            QMetaObject::connectSlotsByName(DataTableWindow);
+        }
+};
+
+#endif // UI_DATATABLEWINDOW_H
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef UI_DIFFWINDOW_H
+#define UI_DIFFWINDOW_H
+
+// user interface for DiffWindow class
+
+#include <QDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QIcon>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTableWidgetItem>
+#include <QVBoxLayout>
+#include "jsondiff.h"
+#include "jsonquery.h"
+
+class Ui_DiffWindow {
+
+    public:
+        const QStringList headers =
+            { QStringLiteral("Změna"), QStringLiteral("Cesta"),
+              QStringLiteral("Původní hodnota"), QStringLiteral("Nová hodnota") };
+
+        // larger number of changes is counted but not listed
+        const static int maxDisplayedChanges = 10000;
+        // longer values are shortened in table (see tooltip for whole value)
+        const static int maxValueLength = 200;
+
+        QIcon * diffWindowIcon;
+
+        QLabel * comparedLabel;
+        QLabel * summaryLabel;
+
+        QTableWidget * changesTable;
+
+        QHBoxLayout * buttonsLayout;
+        QPushButton * closeButton;
+
+        QVBoxLayout * windowLayout;
+
+        void setupUi(QDialog * DiffWindow, const JsonDiff & diff,
+                     const QString & beforeTitle, const QString & afterTitle) {
+
+            const QVector<JsonDiff::Change> & changes = diff.changes();
+            const int noOfRows = qMin(changes.size(), maxDisplayedChanges);
+
+            // properties of main window
+            diffWindowIcon = new QIcon(QStringLiteral(":/icons/icons/system-switch-user.png"));
+            DiffWindow->setWindowIcon(*diffWindowIcon);
+            DiffWindow->resize(900,600);
+            DiffWindow->setWindowTitle(QStringLiteral("Porovnání odpovědí"));
+
+            comparedLabel = new QLabel(beforeTitle + QStringLiteral("  →  ") + afterTitle);
+            comparedLabel->setStyleSheet("font-weight:bold; font-size:12px;");
+
+            // summary
+            int count[3] = { 0, 0, 0 };
+            for (const auto & it: changes)
+                ++count[it.type];
+            QString summary = (diff.isEqual()) ? QStringLiteral("odpovědi jsou shodné") :
+                QStringLiteral("změn: ") + QString::number(changes.size()) +
+                QStringLiteral(" (přidáno: ") + QString::number(count[JsonDiff::ADDED]) +
+                QStringLiteral(", odebráno: ") + QString::number(count[JsonDiff::REMOVED]) +
+                QStringLiteral(", změněno: ") + QString::number(count[JsonDiff::CHANGED]) + QStringLiteral(")");
+            if (noOfRows < changes.size())
+                summary += QStringLiteral(", zobrazeno prvních ") + QString::number(noOfRows);
+            summaryLabel = new QLabel(summary);
+
+            // table
+            changesTable = new QTableWidget(noOfRows, headers.size(), DiffWindow);
+            changesTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+            changesTable->setHorizontalHeaderLabels(headers);
+            changesTable->verticalHeader()->hide();
+            changesTable->horizontalHeader()->setStretchLastSection(true);
+
+            const QStringList types =
+                { QStringLiteral("přidáno"), QStringLiteral("odebráno"), QStringLiteral("změněno") };
+            const QColor colours[3] = { QColor(210,255,166), QColor(255,210,210), QColor(255,245,180) };
+
+            for (int row = 0; row < noOfRows; ++row) {
+
+                const JsonDiff::Change & change = changes.at(row);
+                const QString before = (change.before.isUndefined()) ? QString() :
+                    JsonQuery::toText(QVector<QJsonValue>{ change.before }, true);
+                const QString after = (change.after.isUndefined()) ? QString() :
+                    JsonQuery::toText(QVector<QJsonValue>{ change.after }, true);
+                const QStringList description = { types.at(change.type), change.path, before, after };
+
+                for (int i = 0; i < description.size(); ++i) {
+
+                    QTableWidgetItem * column = new QTableWidgetItem;
+                    column->setText((description.at(i).size() > maxValueLength) ?
+                                    description.at(i).left(maxValueLength) + QStringLiteral("…") : description.at(i));
+                    if (description.at(i).size() > maxValueLength)
+                        column->setToolTip(description.at(i).left(20 * maxValueLength));
+                    column->setFlags(column->flags() & ~Qt::ItemIsEditable);
+                    if (i == 0)
+                        column->setBackground(QBrush(colours[change.type]));
+                    changesTable->setItem(row, i, column);
+                }
+            }
+
+            for (int i = 0; i < headers.size(); ++i)
+                changesTable->horizontalHeaderItem(i)->setTextAlignment(Qt::AlignLeft);
+            changesTable->resizeColumnsToContents();
+
+            // buttons
+            buttonsLayout = new QHBoxLayout;
+            closeButton = new QPushButton(QIcon(QStringLiteral(":/icons/icons/edit-delete.png")),
+                                          QStringLiteral("Zavřít"));
+            buttonsLayout->addStretch();
+            buttonsLayout->addWidget(closeButton);
+
+            windowLayout = new QVBoxLayout(DiffWindow);
+            windowLayout->addWidget(comparedLabel);
+            windowLayout->addWidget(summaryLabel);
+            windowLayout->addWidget(changesTable);
+            windowLayout->addLayout(buttonsLayout);
+
+            QMetaObject::connectSlotsByName(DiffWindow);
+        }
+};
+
+#endif // UI_DIFFWINDOW_H
@@ -12,35 +12,52 @@
 #include <QHBoxLayout>
 #include <QHeaderView>
 #include <QIcon>
+#include <QLabel>
+#include <QLineEdit>
 #include <QPushButton>
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QTabWidget>
+#include <QTableView>
 #include <QVBoxLayout>
-#include <QVector>
-#include "request.h"
+#include "communicationmodel.h"
+#include "journalmodel.h"
+#include "jsonviewer.h"
 
 class Ui_LogWindow {
 
     public:
-        const QStringList headers =
-            { QStringLiteral("ID"), QStringLiteral("Datum a čas"), QStringLiteral("HTTP metoda"),
-              QStringLiteral("URL adresa"), QStringLiteral("Status")};
-
         QIcon * logWindowIcon;
 
-        QTableWidget * listOfCommunicationTable;
+        QHBoxLayout * queryLayout;
+        QLineEdit * queryLineEdit;
+        QPushButton * queryButton;
+
+        QTabWidget * historyTabWidget;
+        QTableView * listOfCommunicationTable;
+
+        QWidget * journalTab;
+        QHBoxLayout * searchLayout;
+        QLineEdit * searchLineEdit;
+        QPushButton * searchButton;
+        QLabel * searchResultLabel;
+        QTableView * journalTableView;
+        JsonViewer * journalBodyViewer;
+        QVBoxLayout * journalLayout;
 
         QHBoxLayout * buttonsLayout;
         QPushButton * displayRequestButton;
         QPushButton * displayResponseButton;
+        QPushButton * compareButton;
+        QPushButton * exportTimingButton;
+        QPushButton * exportHarButton;
+        QPushButton * importHarButton;
         QPushButton * closeButton;
 
         QVBoxLayout * windowLayout;
 
-        void setupUi(QDialog * LogWindow, const QVector<Communication> & communication) {
+        void setupUi(QDialog * LogWindow, CommunicationModel * const communicationModel,
+                     JournalModel * const journalModel) {
 
-            const int16_t noOfRows = communication.size();
-            const uint8_t noOfColumns = 5;
+            const int noOfRows = communicationModel->rowCount();
 
             // properties of main window
             logWindowIcon = new QIcon(QStringLiteral(":/icons/icons/system-switch-user.png"));
@@ -50,73 +67,101 @@ class Ui_LogWindow {
                                   QString::number(noOfRows) + QStringLiteral(")");
             LogWindow->setWindowTitle(title);
 
-            // table
-            listOfCommunicationTable = new QTableWidget(noOfRows, noOfColumns, LogWindow);
+            // query evaluated against all responses (result is shown in additional column)
+            queryLayout = new QHBoxLayout;
+            queryLineEdit = new QLineEdit;
+            queryLineEdit->setPlaceholderText(QStringLiteral("dotaz, např. Data[?Deleted==false].ID"));
+            queryLineEdit->setClearButtonEnabled(true);
+            queryButton = new QPushButton(QStringLiteral(" Vyhodnotit "));
+            queryLayout->addWidget(queryLineEdit);
+            queryLayout->addWidget(queryButton);
+
+            // table (only visible rows are rendered)
+            listOfCommunicationTable = new QTableView(LogWindow);
+            listOfCommunicationTable->setModel(communicationModel);
             listOfCommunicationTable->setSelectionBehavior(QAbstractItemView::SelectRows);
-            listOfCommunicationTable->setHorizontalHeaderLabels(headers);
+            listOfCommunicationTable->setWordWrap(false);
             listOfCommunicationTable->verticalHeader()->hide();
-
-            // fill rows
-            uint16_t row = 0;
-            for (auto it: communication) {
-
-                const QString date = it.createDate().toString("dd.MM.yyyy hh:mm:ss.zzz");
-                const QString method = http::convertEnumValueToText(it.request().httpMethod());
-                const QString url = it.request().request().url().toDisplayString();
-                const QString status =
-                    QString::number(static_cast<int>(it.response().statusCode())) + " " +
-                    it.response().statusDescription();
-
-                const QStringList description =
-                    { QString::number(it.ID()), date, method, url, status };
-
-                for (int i = 0; i < noOfColumns; ++i) {
-
-                    QTableWidgetItem * column = new QTableWidgetItem;
-                    column->setText(description.at(i));
-                    column->setFlags(column->flags() & ~Qt::ItemIsEditable);
-
-                    if (i == 0)
-                        column->setBackground(QBrush(http::httpMethods[method]._color));
-                    else
-                        switch (it.response().statusCode()) {
-                            case TEST: break;
-                            case OK: column->setBackground(QBrush(QColor(210,255,166))); break;
-                            default: column->setBackground(QBrush(QColor(255,210,210)));
-                        }
-
-                    listOfCommunicationTable->setItem(row, i, column);
-                }
-                ++row;
-            }
-
-            for (int i = 0; i < noOfColumns; ++i) {
-
-                listOfCommunicationTable->horizontalHeaderItem(i)->setTextAlignment(Qt::AlignLeft);
+            listOfCommunicationTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+            listOfCommunicationTable->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft);
+            listOfCommunicationTable->horizontalHeader()->setStretchLastSection(true);
+            listOfCommunicationTable->setColumnHidden(CommunicationModel::QUERY_RESULT, true);
+            for (int i = 0; i < CommunicationModel::QUERY_RESULT; ++i)
                 listOfCommunicationTable->resizeColumnToContents(i);
-            }
+            listOfCommunicationTable->setColumnWidth(CommunicationModel::DURATION,
+                listOfCommunicationTable->fontMetrics().horizontalAdvance(QStringLiteral(" 000000 ms ")));
+            listOfCommunicationTable->scrollToBottom();
 
             // buttons
             buttonsLayout = new QHBoxLayout();
             displayRequestButton = new QPushButton(QStringLiteral(" Zobrazit request "));
             displayResponseButton = new QPushButton(QStringLiteral(" Zobrazit response "));
-            if (noOfRows == 0) {
-                displayRequestButton->setEnabled(false);
-                displayResponseButton->setEnabled(false);
-            }
+            displayRequestButton->setEnabled(false);
+            displayResponseButton->setEnabled(false);
+            // two selected responses are compared
+            compareButton = new QPushButton(QStringLiteral(" Porovnat "));
+            compareButton->setEnabled(false);
+            // percentiles of durations per endpoint (rows of current tab)
+            exportTimingButton = new QPushButton(QStringLiteral(" Export časů "));
+            // HAR 1.2 (rows of current tab are exported, imported entries are added to journal)
+            exportHarButton = new QPushButton(QStringLiteral(" Export HAR "));
+            importHarButton = new QPushButton(QStringLiteral(" Import HAR "));
             closeButton = new QPushButton(QIcon(QStringLiteral(":/icons/icons/edit-delete.png")),
                                           QStringLiteral("Zavřít"));
 
+            buttonsLayout->addWidget(exportTimingButton);
+            buttonsLayout->addWidget(exportHarButton);
+            buttonsLayout->addWidget(importHarButton);
             buttonsLayout->addStretch();
+            buttonsLayout->addWidget(compareButton);
             buttonsLayout->addWidget(displayRequestButton);
             buttonsLayout->addWidget(displayResponseButton);
             buttonsLayout->addWidget(closeButton);
 
+            listOfCommunicationTable->setSizeAdjustPolicy(QAbstractScrollArea::AdjustToContents);
+
+            // journal (messages of all sessions); only visible rows are read
+            journalTab = new QWidget;
+            // full-text search in url, headers and bodies (see Journal::search())
+            searchLayout = new QHBoxLayout;
+            searchLineEdit = new QLineEdit;
+            searchLineEdit->setPlaceholderText(QStringLiteral("hledat v URL, hlavičkách a tělech (alespoň ") +
+                QString::number(TrigramIndex::minQueryLength) + QStringLiteral(" znaky)"));
+            searchLineEdit->setClearButtonEnabled(true);
+            searchButton = new QPushButton(QStringLiteral(" Hledat "));
+            searchResultLabel = new QLabel;
+            searchLayout->addWidget(searchLineEdit);
+            searchLayout->addWidget(searchButton);
+            searchLayout->addWidget(searchResultLabel);
+            journalTableView = new QTableView;
+            journalTableView->setModel(journalModel);
+            journalTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+            journalTableView->setSelectionMode(QAbstractItemView::SingleSelection);
+            journalTableView->setWordWrap(false);
+            journalTableView->verticalHeader()->hide();
+            journalTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+            journalTableView->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft);
+            journalTableView->horizontalHeader()->setStretchLastSection(true);
+            journalTableView->setColumnWidth(1, journalTableView->fontMetrics().horizontalAdvance(
+                QStringLiteral("00.00.0000 00:00:00.000 ")));
+            journalTableView->setColumnWidth(3, 400);
+            journalTableView->scrollToBottom();
+            journalBodyViewer = new JsonViewer;
+            journalBodyViewer->setMinimumHeight(journalBodyViewer->fontMetrics().height() * 10);
+            journalLayout = new QVBoxLayout(journalTab);
+            journalLayout->addLayout(searchLayout);
+            journalLayout->addWidget(journalTableView, 2);
+            journalLayout->addWidget(journalBodyViewer, 1);
+
+            historyTabWidget = new QTabWidget;
+            historyTabWidget->addTab(listOfCommunicationTable, QStringLiteral("Aktuální relace"));
+            historyTabWidget->addTab(journalTab, QStringLiteral("Deník (záznamů: ") +
+                                     QString::number(journalModel->rowCount()) + QStringLiteral(")"));
+
             windowLayout = new QVBoxLayout(LogWindow);
-            windowLayout->addWidget(listOfCommunicationTable);
+            windowLayout->addLayout(queryLayout);
+            windowLayout->addWidget(historyTabWidget);
             windowLayout->addLayout(buttonsLayout);
-
-            listOfCommunicationTable->setSizeAdjustPolicy(QAbstractScrollArea::AdjustToContents);
             LogWindow->adjustSize();
 
             QMetaObject::connectSlotsByName(LogWindow);
@@ -106,6 +106,7 @@ class Ui_MainWindow {
         QLabel * swaggerLabel;
         QLineEdit * swaggerWebLocationLineEdit;
         QLineEdit * swaggerFileLocationLineEdit;
+        QComboBox * swaggerVersionComboBox;
         QPushButton * changeSwaggerLocationButton;
         QPushButton * swaggerFromWebButton;
         QPushButton * swaggerFromFileButton;
@@ -130,6 +131,8 @@ class Ui_MainWindow {
         QLabel * filterLabel;
         QLineEdit * filterConditionLineEdit;
         QCheckBox * useOwnFilterConditionCheckBox;
+        QLabel * allPagesLabel;
+        QCheckBox * allPagesCheckBox;
 
         // buttons
         QHBoxLayout * buttonsLayout;
@@ -138,6 +141,7 @@ class Ui_MainWindow {
         QCheckBox * testModeCheckBox;
         QLabel * testModeLabel;
         QPushButton * logButton;
+        QPushButton * replayButton;
         QPushButton * quitButton;
 
         void resizeLineWidget(QLineEdit * const lineEdit, const QString & time) {
@@ -325,6 +329,9 @@ class Ui_MainWindow {
             swaggerWebLocationLineEdit = new QLineEdit;
             swaggerFileLocationLineEdit = new QLineEdit;
             swaggerFileLocationLineEdit->setHidden(true);
+            swaggerVersionComboBox = new QComboBox;
+            swaggerVersionComboBox->setToolTip(QStringLiteral("Verze Swagger dokumentace"));
+            swaggerVersionComboBox->setHidden(true);
             changeSwaggerLocationButton = new QPushButton
                 (QIcon(QStringLiteral(":/icons/icons/emblem-symbolic-link.png")),
                  QStringLiteral("Zdroj"));
@@ -339,6 +346,7 @@ class Ui_MainWindow {
             docLayout->addWidget(swaggerLabel);
             docLayout->addWidget(swaggerWebLocationLineEdit);
             docLayout->addWidget(swaggerFileLocationLineEdit);
+            docLayout->addWidget(swaggerVersionComboBox);
             docLayout->addWidget(changeSwaggerLocationButton);
             docLayout->addWidget(swaggerFromWebButton);
             docLayout->addWidget(swaggerFromFileButton);
@@ -389,6 +397,8 @@ class Ui_MainWindow {
             filterLabel = new QLabel(QStringLiteral("Filter"));
             filterConditionLineEdit = new QLineEdit;
             useOwnFilterConditionCheckBox = new QCheckBox;
+            allPagesLabel = new QLabel(QStringLiteral("Načíst všechny stránky (cesta končí /{from}/{count})"));
+            allPagesCheckBox = new QCheckBox;
             if (http::httpMethods[requestMethodComboBox->currentText()]._dtoObjectType != http::OUTPUT)
                 requestSelectAndFilterWidget->setEnabled(false);
             // layout
@@ -399,6 +409,8 @@ class Ui_MainWindow {
             requestSelectAndFilterLayout->addWidget(filterLabel, 1, 0);
             requestSelectAndFilterLayout->addWidget(filterConditionLineEdit, 1, 1);
             requestSelectAndFilterLayout->addWidget(useOwnFilterConditionCheckBox, 1, 2);
+            requestSelectAndFilterLayout->addWidget(allPagesLabel, 2, 1, Qt::AlignRight);
+            requestSelectAndFilterLayout->addWidget(allPagesCheckBox, 2, 2);
             // group box layout
             requestLayout->addLayout(requestEndpointLayout);
             requestLayout->addWidget(requestSelectAndFilterWidget);
@@ -411,6 +423,7 @@ class Ui_MainWindow {
             testModeLabel = new QLabel(QStringLiteral("Testovací režim"));
             logButton = new QPushButton
                 (QIcon(QStringLiteral(":/icons/icons/address-book-new.png")), QStringLiteral("Log"));
+            replayButton = new QPushButton(QStringLiteral("Přehrát"));
             quitButton = new QPushButton(QStringLiteral("Ukončit"));
             // layout
             buttonsLayout = new QHBoxLayout;
@@ -420,6 +433,7 @@ class Ui_MainWindow {
             buttonsLayout->addWidget(testModeLabel);
             buttonsLayout->addStretch();
             buttonsLayout->addWidget(logButton);
+            buttonsLayout->addWidget(replayButton);
             buttonsLayout->addWidget(quitButton);
 
             windowLayout = new QVBoxLayout(MainWindow);
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef UI_REPLAYWINDOW_H
+#define UI_REPLAYWINDOW_H
+
+// user interface for ReplayWindow class
+
+#include <QComboBox>
+#include <QDialog>
+#include <QDoubleSpinBox>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QIcon>
+#include <QLabel>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QVBoxLayout>
+#include "journal.h"
+
+class Ui_ReplayWindow {
+
+    public:
+        const QStringList headers =
+            { QStringLiteral("Záznam"), QStringLiteral("HTTP metoda"), QStringLiteral("URL adresa"),
+              QStringLiteral("Status (záznam)"), QStringLiteral("Status (nyní)"),
+              QStringLiteral("Doba (záznam) [ms]"), QStringLiteral("Doba (nyní) [ms]"),
+              QStringLiteral("Rozdíl [ms]") };
+
+        QIcon * replayWindowIcon;
+
+        QGridLayout * settingsLayout;
+        QLabel * rangeLabel;
+        QSpinBox * firstEntrySpinBox;
+        QLabel * rangeSeparatorLabel;
+        QSpinBox * lastEntrySpinBox;
+        QLabel * pacingLabel;
+        QComboBox * pacingComboBox;
+        QLabel * scaleLabel;
+        QDoubleSpinBox * scaleSpinBox;
+        QLabel * inFlightLabel;
+        QSpinBox * inFlightSpinBox;
+
+        QTableWidget * resultsTable;
+        QLabel * summaryLabel;
+
+        QHBoxLayout * buttonsLayout;
+        QPushButton * startButton;
+        QPushButton * closeButton;
+
+        QVBoxLayout * windowLayout;
+
+        void setupUi(QDialog * ReplayWindow, const Journal * const journal) {
+
+            const int entryCount = (journal != nullptr) ? static_cast<int>(journal->entryCount()) : 0;
+
+            // properties of main window
+            replayWindowIcon = new QIcon(QStringLiteral(":/icons/icons/system-switch-user.png"));
+            ReplayWindow->setWindowIcon(*replayWindowIcon);
+            ReplayWindow->resize(900,500);
+            ReplayWindow->setWindowTitle(QStringLiteral("Přehrání zaznamenané komunikace"));
+
+            // settings (entries are numbered from 1 as in journal's view)
+            settingsLayout = new QGridLayout;
+            rangeLabel = new QLabel(QStringLiteral("Záznamy deníku"));
+            firstEntrySpinBox = new QSpinBox;
+            firstEntrySpinBox->setRange(1, qMax(1, entryCount));
+            firstEntrySpinBox->setValue(1);
+            rangeSeparatorLabel = new QLabel(QStringLiteral("až"));
+            lastEntrySpinBox = new QSpinBox;
+            lastEntrySpinBox->setRange(1, qMax(1, entryCount));
+            lastEntrySpinBox->setValue(qMax(1, entryCount));
+
+            pacingLabel = new QLabel(QStringLiteral("Časování"));
+            pacingComboBox = new QComboBox;
+            pacingComboBox->addItems({ QStringLiteral("původní"), QStringLiteral("původní × násobek"),
+                                       QStringLiteral("co nejrychleji") });
+            scaleLabel = new QLabel(QStringLiteral("Násobek"));
+            scaleSpinBox = new QDoubleSpinBox;
+            scaleSpinBox->setRange(0.01, 100.0);
+            scaleSpinBox->setSingleStep(0.1);
+            scaleSpinBox->setValue(1.0);
+            scaleSpinBox->setEnabled(false);
+            inFlightLabel = new QLabel(QStringLiteral("Souběžně"));
+            inFlightSpinBox = new QSpinBox;
+            inFlightSpinBox->setRange(1, 64);
+            inFlightSpinBox->setValue(4);
+            inFlightSpinBox->setEnabled(false);
+
+            settingsLayout->addWidget(rangeLabel, 0, 0);
+            settingsLayout->addWidget(firstEntrySpinBox, 0, 1);
+            settingsLayout->addWidget(rangeSeparatorLabel, 0, 2);
+            settingsLayout->addWidget(lastEntrySpinBox, 0, 3);
+            settingsLayout->addWidget(pacingLabel, 1, 0);
+            settingsLayout->addWidget(pacingComboBox, 1, 1);
+            settingsLayout->addWidget(scaleLabel, 1, 2);
+            settingsLayout->addWidget(scaleSpinBox, 1, 3);
+            settingsLayout->addWidget(inFlightLabel, 1, 4);
+            settingsLayout->addWidget(inFlightSpinBox, 1, 5);
+            settingsLayout->setColumnStretch(6, 1);
+
+            // results (one row per replayed request)
+            resultsTable = new QTableWidget(0, headers.size(), ReplayWindow);
+            resultsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+            resultsTable->setHorizontalHeaderLabels(headers);
+            resultsTable->verticalHeader()->hide();
+            resultsTable->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch);
+            for (int i = 0; i < headers.size(); ++i)
+                resultsTable->horizontalHeaderItem(i)->setTextAlignment(Qt::AlignLeft);
+            summaryLabel = new QLabel;
+
+            // buttons
+            buttonsLayout = new QHBoxLayout;
+            startButton = new QPushButton(QStringLiteral(" Přehrát "));
+            startButton->setEnabled(entryCount != 0);
+            closeButton = new QPushButton(QIcon(QStringLiteral(":/icons/icons/edit-delete.png")),
+                                          QStringLiteral("Zavřít"));
+            buttonsLayout->addWidget(summaryLabel);
+            buttonsLayout->addStretch();
+            buttonsLayout->addWidget(startButton);
+            buttonsLayout->addWidget(closeButton);
+
+            windowLayout = new QVBoxLayout(ReplayWindow);
+            windowLayout->addLayout(settingsLayout);
+            windowLayout->addWidget(resultsTable);
+            windowLayout->addLayout(buttonsLayout);
+
+            QMetaObject::connectSlotsByName(ReplayWindow);
+        }
+};
+
+#endif // UI_REPLAYWINDOW_H
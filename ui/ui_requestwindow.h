@@ -119,9 +119,17 @@ class Ui_RequestWindow {
             requestBodyTextEdit->setReadOnly(true);
             requestBodyTextEdit->setWordWrapMode(QTextOption::WrapAnywhere);
             requestBodyTextEdit->setPlaceholderText(QStringLiteral("prázdné"));
-            const QString bodyContents(request.body());
+            bool bodyRead = true;
+            const QString bodyContents(request.body(&bodyRead));
             if (!bodyContents.isEmpty())
                 requestBodyTextEdit->setPlainText(bodyContents);
+            // body evicted from history (see StoredBody) may not be restorable
+            if (!bodyRead) {
+
+                requestBodyTextEdit->setPlaceholderText(
+                    QStringLiteral("tělo zprávy se nepodařilo načíst z archivu historie"));
+                requestBodyTextEdit->setStyleSheet(QStringLiteral("color:red;"));
+            }
             fontMetrics = requestBodyTextEdit->fontMetrics();
             size = requestBodyTextEdit->size();
             height = fontMetrics.height() * 10;
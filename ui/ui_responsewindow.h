@@ -20,6 +20,7 @@
 #include <QTextEdit>
 #include <QVBoxLayout>
 #include <QVector>
+#include "jsonviewer.h"
 #include "request.h"
 
 class Ui_ResponseWindow {
@@ -32,11 +33,16 @@ class Ui_ResponseWindow {
         QHBoxLayout * statusLayout;
         QLabel * statusCodeLabel;
         QLabel * statusDescriptionLabel;
+        QLabel * timingLabel;
         QPushButton * httpMethodButton;
 
         QLineEdit * responseQueryLineEdit;
         QTextEdit * responseHeaderTextEdit;
         QTextEdit * responseBodyTextEdit;
+        JsonViewer * responseBodyViewer;
+
+        QLineEdit * jsonQueryLineEdit;
+        QTextEdit * jsonQueryResultTextEdit;
 
         QGridLayout * stateAttributesLayout;
         QLabel * pageCountLabel;
@@ -52,17 +58,17 @@ class Ui_ResponseWindow {
 
         QHBoxLayout * buttonsLayout;
         QLineEdit * tableNameLineEdit;
+        QPushButton * dataTableButton;
         QPushButton * verifyButton;
         QPushButton * closeButton;
 
         QVBoxLayout * windowLayout;
 
         void setupUi(QDialog * ResponseWindow, const QNetworkReply * const reply,
-                     const QVariant & ID, QList<QString> & recordIDs, Communication * const comm) {
+                     const QVariant & ID, QVector<QUuid> & recordIDs, Communication * const comm) {
 
             const QList<QNetworkReply::RawHeaderPair> headers = reply->rawHeaderPairs();
-            Response * const currentResponse = new Response;
-            *currentResponse = comm->response();
+            const Response * const currentResponse = &(comm->response());
 
             // properties of main window
             responseWindowIcon = new QIcon(QStringLiteral(":/icons/icons/system-switch-user.png"));
@@ -119,6 +125,11 @@ class Ui_ResponseWindow {
             statusLayout->addWidget(httpMethodButton);
             statusLayout->setSizeConstraint(QLayout::SetFixedSize);
 
+            // duration of message's phases (see RequestTiming)
+            timingLabel = new QLabel(comm->timing().breakdown());
+            timingLabel->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
+            timingLabel->setHidden(!comm->timing().isValid());
+
             // response query contents (following ?)
             const QString query = reply->request().url().query(QUrl::PrettyDecoded);
             responseQueryLineEdit = new QLineEdit(query);
@@ -145,16 +156,67 @@ class Ui_ResponseWindow {
             responseBodyTextEdit->setReadOnly(true);
             responseBodyTextEdit->setWordWrapMode(QTextOption::WrapAnywhere);
             responseBodyTextEdit->setPlaceholderText(QStringLiteral("prázdné"));
-            QString bodyContents = currentResponse->dataFromBody(recordIDs);
-            if (bodyContents.isNull() && currentResponse->stateAttributes().status.isNull())
-                bodyContents = currentResponse->response();
-            responseBodyTextEdit->setPlainText(bodyContents);
+            // data section is located in raw body (see JsonViewer and DataTableWindow)
+            // body is decompressed on every access (see StoredBody) => it is read once
+            bool bodyRead = true;
+            const QByteArray contents = currentResponse->response(&bodyRead);
+            qint64 dataBegin = 0;
+            qint64 dataEnd = -1;
+            QVector<QUuid> dataRecordIDs;
+            const bool dataLocated = currentResponse->locateData(dataBegin, dataEnd, dataRecordIDs);
+
+            // very large body is shown by virtualized viewer (only visible lines are formatted)
+            responseBodyViewer = new JsonViewer;
+            const bool largeBody = (contents.size() > JsonViewer::sizeThreshold);
+            if (largeBody) {
+
+                if (dataLocated)
+                    recordIDs = dataRecordIDs;
+                responseBodyViewer->setContents(contents,
+                                                (dataLocated) ? dataBegin : 0, (dataLocated) ? dataEnd : -1);
+            }
+            else {
+
+                QString bodyContents = currentResponse->dataFromBody(recordIDs);
+                if (bodyContents.isNull() && currentResponse->stateAttributes().status.isNull())
+                    bodyContents = contents;
+                responseBodyTextEdit->setPlainText(bodyContents);
+            }
+            // body evicted from history (see StoredBody) may not be restorable
+            if (!bodyRead) {
+
+                responseBodyTextEdit->setPlaceholderText(
+                    QStringLiteral("tělo odpovědi se nepodařilo načíst z archivu historie"));
+                responseBodyTextEdit->setStyleSheet(QStringLiteral("color:red;"));
+            }
+            responseBodyTextEdit->setHidden(largeBody);
+            responseBodyViewer->setHidden(!largeBody);
             fontMetrics = responseBodyTextEdit->fontMetrics();
             size = responseBodyTextEdit->size();
             height = fontMetrics.height() * 10;
             if (height > size.height())
               responseBodyTextEdit->resize(size.width(), height);
             responseBodyTextEdit->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Minimum);
+            responseBodyViewer->setMinimumHeight(height);
+
+            // query evaluated against parsed body (see JsonQuery); body is parsed only when
+            // query is submitted => json document is recognized by its first character
+            int firstChar = 0;
+            while (firstChar < contents.size() && (contents.at(firstChar) == ' ' ||
+                   contents.at(firstChar) == '\t' || contents.at(firstChar) == '\r' ||
+                   contents.at(firstChar) == '\n'))
+                ++firstChar;
+            const bool jsonBody = (firstChar < contents.size() &&
+                                   (contents.at(firstChar) == '{' || contents.at(firstChar) == '['));
+            jsonQueryLineEdit = new QLineEdit;
+            jsonQueryLineEdit->setPlaceholderText(QStringLiteral("dotaz, např. Data[?Deleted==false].ID"));
+            jsonQueryLineEdit->setClearButtonEnabled(true);
+            jsonQueryLineEdit->setHidden(!jsonBody);
+            jsonQueryResultTextEdit = new QTextEdit;
+            jsonQueryResultTextEdit->setReadOnly(true);
+            jsonQueryResultTextEdit->setPlaceholderText(QStringLiteral("žádný výsledek"));
+            jsonQueryResultTextEdit->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Minimum);
+            jsonQueryResultTextEdit->setHidden(true);
 
             // response state attributes
             uint8_t rowNo = 0;
@@ -204,9 +266,18 @@ class Ui_ResponseWindow {
                 ":/icons/icons/preferences-desktop-notification.png")), QStringLiteral(" Neověřeno "));
             if (recordIDs.isEmpty())
                 verifyButton->setHidden(true);
+            // data section containing array of objects can be shown as table
+            dataTableButton = new QPushButton(QIcon(QStringLiteral(
+                ":/icons/icons/document-preview.png")), QStringLiteral(" Tabulka "));
+            const QByteArray dataStart = (dataLocated) ? contents.mid(
+                static_cast<int>(dataBegin), static_cast<int>(qMin(dataEnd - dataBegin, static_cast<qint64>(64))))
+                                                       : QByteArray();
+            dataTableButton->setHidden(!(dataStart.startsWith('[') &&
+                                         dataStart.mid(1).trimmed().startsWith('{')));
             closeButton = new QPushButton(QIcon(QStringLiteral(":/icons/icons/edit-delete.png")),
                                           QStringLiteral("Zavřít"));
             buttonsLayout->addStretch();
+            buttonsLayout->addWidget(dataTableButton);
             buttonsLayout->addWidget(tableNameLineEdit);
             buttonsLayout->addWidget(verifyButton);
             buttonsLayout->addWidget(closeButton);
@@ -214,9 +285,13 @@ class Ui_ResponseWindow {
             windowLayout = new QVBoxLayout(ResponseWindow);
             windowLayout->addWidget(endpointNameLabel);
             windowLayout->addLayout(statusLayout);
+            windowLayout->addWidget(timingLabel);
             windowLayout->addWidget(responseQueryLineEdit);
             windowLayout->addWidget(responseHeaderTextEdit);
             windowLayout->addWidget(responseBodyTextEdit);
+            windowLayout->addWidget(responseBodyViewer);
+            windowLayout->addWidget(jsonQueryLineEdit);
+            windowLayout->addWidget(jsonQueryResultTextEdit);
             windowLayout->addLayout(stateAttributesLayout);
             windowLayout->addLayout(buttonsLayout);
 
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "jsonscanner.h"
+#include "uuidscanner.h"
+
+bool UuidScanner::hexToBytes(const char * const hex, uchar * const bytes) {
+
+#ifdef __SSE2__
+    // 2 x 16 hex digits: validation (0-9, a-f, A-F) and conversion without branching per digit
+    __m128i packed[2];
+
+    for (int half = 0; half < 2; ++half) {
+
+        const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hex + 16 * half));
+        const __m128i lowerCase = _mm_or_si128(digits, _mm_set1_epi8(0x20));
+
+        // bytes >= 0x80 are negative (signed comparison) => they fail both tests
+        const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(digits, _mm_set1_epi8('0' - 1)),
+                                              _mm_cmplt_epi8(digits, _mm_set1_epi8('9' + 1)));
+        const __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(lowerCase, _mm_set1_epi8('a' - 1)),
+                                               _mm_cmplt_epi8(lowerCase, _mm_set1_epi8('f' + 1)));
+        if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF)
+            return false;
+
+        const __m128i nibbles = _mm_or_si128(
+            _mm_and_si128(isDigit, _mm_sub_epi8(digits, _mm_set1_epi8('0'))),
+            _mm_andnot_si128(isDigit, _mm_sub_epi8(lowerCase, _mm_set1_epi8('a' - 10))));
+
+        // every 16-bit lane holds two nibbles (first digit in lower byte) => one byte
+        const __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+        const __m128i low = _mm_srli_epi16(nibbles, 8);
+        packed[half] = _mm_or_si128(high, low);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(bytes), _mm_packus_epi16(packed[0], packed[1]));
+    return true;
+#else
+    // 0xFF = not a hex digit
+    static uchar values[256];
+    static bool valuesSet = false;
+    if (!valuesSet) {
+
+        memset(values, 0xFF, sizeof(values));
+        for (int i = 0; i < 10; ++i)
+            values['0' + i] = static_cast<uchar>(i);
+        for (int i = 0; i < 6; ++i)
+            values['a' + i] = values['A' + i] = static_cast<uchar>(10 + i);
+        valuesSet = true;
+    }
+
+    uchar invalid = 0;
+    for (int i = 0; i < 16; ++i) {
+
+        const uchar high = values[static_cast<uchar>(hex[2 * i])];
+        const uchar low = values[static_cast<uchar>(hex[2 * i + 1])];
+        invalid |= (high | low) & 0xF0;
+        bytes[i] = static_cast<uchar>((high << 4) | (low & 0x0F));
+    }
+    return (invalid == 0);
+#endif
+}
+
+// text must contain (at least) 36 characters
+bool UuidScanner::read(const char * const text, QUuid & uuid) {
+
+    if (text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-')
+        return false;
+
+    // groups of hex digits are joined (without dashes)
+    char hex[32];
+    memcpy(hex, text, 8);
+    memcpy(hex + 8, text + 9, 4);
+    memcpy(hex + 12, text + 14, 4);
+    memcpy(hex + 16, text + 19, 4);
+    memcpy(hex + 20, text + 24, 12);
+
+    uchar bytes[16];
+    if (!hexToBytes(hex, bytes))
+        return false;
+
+    // null uuid is not valid record ID
+    const uint l = (static_cast<uint>(bytes[0]) << 24) | (static_cast<uint>(bytes[1]) << 16) |
+                   (static_cast<uint>(bytes[2]) << 8) | static_cast<uint>(bytes[3]);
+    uuid = QUuid(l, static_cast<ushort>((bytes[4] << 8) | bytes[5]),
+                 static_cast<ushort>((bytes[6] << 8) | bytes[7]),
+                 bytes[8], bytes[9], bytes[10], bytes[11], bytes[12], bytes[13], bytes[14], bytes[15]);
+
+    return !(uuid.isNull());
+}
+
+// canonical form with or without braces (the same forms as accepted by QUuid)
+bool UuidScanner::read(const char * const text, const qint64 length, QUuid & uuid) {
+
+    if (length == canonicalLength)
+        return read(text, uuid);
+
+    if (length == canonicalLength + 2 && text[0] == '{' && text[length - 1] == '}')
+        return read(text + 1, uuid);
+
+    return false;
+}
+
+// data starts with json array; end (if requested) is set to position following the array;
+// returns number of elements which are not uuid strings (-1 if array is not valid)
+int UuidScanner::readArray(const char * const data, const qint64 size,
+                           QVector<QUuid> & uuids, qint64 * const end) {
+
+    JsonScanner scanner(data, size);
+    if (!scanner.enterArray())
+        return -1;
+
+    int otherElements = 0;
+    QUuid uuid;
+
+    while (scanner.nextElement()) {
+
+        // fast path: unescaped string of canonical length
+        const qint64 position = scanner.position();
+        if (data[position] == '"' && position + canonicalLength + 1 < size &&
+            data[position + canonicalLength + 1] == '"' && read(data + position + 1, uuid)) {
+
+            uuids.push_back(uuid);
+            scanner.seek(position + canonicalLength + 2);
+            continue;
+        }
+
+        qint64 valueBegin = 0;
+        qint64 valueEnd = 0;
+        if (!scanner.skipValue(&valueBegin, &valueEnd))
+            break;
+
+        // braced form (or anything else)
+        if (data[valueBegin] == '"' && read(data + valueBegin + 1, valueEnd - valueBegin - 2, uuid))
+            uuids.push_back(uuid);
+        else
+            ++otherElements;
+    }
+
+    if (scanner.hasError())
+        return -1;
+
+    if (end != nullptr)
+        *end = scanner.position();
+
+    return otherElements;
+}
@@ -0,0 +1,29 @@
+/*******************************************************************************
+ Copyright 2020 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef UUIDSCANNER_H
+#define UUIDSCANNER_H
+
+#include <QUuid>
+#include <QVector>
+
+// validation and conversion of canonical uuid strings (xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx)
+// straight from raw bytes; all 32 hex digits are checked and converted at once (SSE2)
+class UuidScanner {
+
+    public:
+        const static int canonicalLength = 36;
+
+        static bool read(const char * const, QUuid &);
+        static bool read(const char * const, const qint64, QUuid &);
+
+        // json array (raw); valid uuid strings are appended, returns number of other elements
+        static int readArray(const char * const, const qint64, QVector<QUuid> &, qint64 * const = nullptr);
+
+    private:
+        static bool hexToBytes(const char * const, uchar * const);
+};
+
+#endif // UUIDSCANNER_H